@@ -1,11 +1,14 @@
 """ESPHome IWR6843 mmWave Radar Component"""
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome import pins
-from esphome.components import spi, uart, sensor, binary_sensor, button, switch, number
+from esphome import automation, pins
+from esphome.components import spi, uart, sensor, binary_sensor, button, switch, number, web_server_base
+from esphome.components.web_server_base import CONF_WEB_SERVER_BASE_ID
 from esphome.const import (
+    CONF_DATA_RATE,
     CONF_ID,
     CONF_NAME,
+    CONF_TRIGGER_ID,
     DEVICE_CLASS_OCCUPANCY,
     DEVICE_CLASS_SAFETY,
     STATE_CLASS_MEASUREMENT,
@@ -30,11 +33,44 @@ CONF_Y_MAX = "y_max"
 CONF_Y_MIN = "y_min"
 CONF_Z_MAX = "z_max"
 CONF_Z_MIN = "z_min"
+CONF_ZONES = "zones"
+CONF_DIAGNOSTICS_INTERVAL = "diagnostics_interval"
+CONF_HOT_PATH_LOGGING = "hot_path_logging"
+CONF_TRACE = "trace"
+CONF_SPI_AUTO_TUNE = "spi_auto_tune"
+CONF_MAX_DATA_RATE = "max_data_rate"
+CONF_ADAPTIVE_FRAME_RATE = "adaptive_frame_rate"
+CONF_IDLE_TIMEOUT = "idle_timeout"
+CONF_IDLE_FRAME_PERIOD = "idle_frame_period"
+CONF_ON_FRAME = "on_frame"
+CONF_MAX_RECOVERY_ATTEMPTS = "max_recovery_attempts"
+CONF_PUBLISH_BUDGET = "publish_budget"
+CONF_TRAJECTORY = "trajectory"
+CONF_CLUTTER_MAP = "clutter_map"
+CONF_LEARNING_TIME = "learning_time"
+CONF_THRESHOLD = "threshold"
+CONF_BUFFER_SIZE = "buffer_size"
+CONF_HANDLER_ID = "handler_id"
+CONF_MOUNTING = "mounting"
+CONF_X = "x"
+CONF_Y = "y"
+CONF_YAW = "yaw"
+CONF_PITCH = "pitch"
+CONF_ROLL = "roll"
+
+MAX_ZONES = 4
+MAX_SPI_DATA_RATE = 40e6  # IWR6843 SPI slave limit
 
 iwr6843_ns = cg.esphome_ns.namespace("iwr6843")
 IWR6843Component = iwr6843_ns.class_(
     "IWR6843Component", cg.Component, spi.SPIDevice, uart.UARTDevice
 )
+RadarFrame = iwr6843_ns.struct("RadarFrame")
+RadarFrameConstRef = RadarFrame.operator("ref").operator("const")
+FrameTrigger = iwr6843_ns.class_(
+    "FrameTrigger", automation.Trigger.template(RadarFrameConstRef)
+)
+TrajectoryHandler = iwr6843_ns.class_("TrajectoryHandler")
 
 # Tracking ID Schema
 TRACKING_ID_SCHEMA = cv.Schema(
@@ -56,6 +92,86 @@ BOUNDARY_SCHEMA = cv.Schema(
     }
 )
 
+# SPI Clock Auto-tune Schema
+SPI_AUTO_TUNE_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_MAX_DATA_RATE, default="20MHz"): cv.All(
+            cv.frequency, cv.float_range(min=1e6, max=MAX_SPI_DATA_RATE)
+        ),
+    }
+)
+
+
+# Adaptive Frame Rate Schema
+ADAPTIVE_FRAME_RATE_SCHEMA = cv.Schema(
+    {
+        cv.Optional(
+            CONF_IDLE_TIMEOUT, default="5min"
+        ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_IDLE_FRAME_PERIOD, default="500ms"): cv.All(
+            cv.positive_time_period_milliseconds,
+            cv.Range(
+                min=cv.TimePeriod(milliseconds=200), max=cv.TimePeriod(milliseconds=1000)
+            ),
+        ),
+    }
+)
+
+
+# Clutter Map Schema
+CLUTTER_MAP_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_LEARNING_TIME, default="10min"): cv.All(
+            cv.positive_time_period_milliseconds,
+            cv.Range(min=cv.TimePeriod(minutes=1)),
+        ),
+        cv.Optional(CONF_THRESHOLD, default=0.5): cv.float_range(min=0.1, max=1.0),
+    }
+)
+
+
+# Mounting Schema (position in the room frame, angles in degrees; height is ceiling_height)
+MOUNTING_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_X, default=0.0): cv.float_range(min=-20.0, max=20.0),
+        cv.Optional(CONF_Y, default=0.0): cv.float_range(min=-20.0, max=20.0),
+        cv.Optional(CONF_YAW, default=0.0): cv.float_range(min=-180.0, max=180.0),
+        cv.Optional(CONF_PITCH, default=90.0): cv.float_range(min=0.0, max=90.0),
+        cv.Optional(CONF_ROLL, default=0.0): cv.float_range(min=-180.0, max=180.0),
+    }
+)
+
+
+# Trajectory History Schema (served by the web server)
+TRAJECTORY_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_HANDLER_ID): cv.declare_id(TrajectoryHandler),
+        cv.GenerateID(CONF_WEB_SERVER_BASE_ID): cv.use_id(
+            web_server_base.WebServerBase
+        ),
+        cv.Optional(CONF_BUFFER_SIZE, default=65536): cv.int_range(
+            min=8192, max=1048576
+        ),
+    }
+)
+
+
+def validate_data_rate(config):
+    if config[CONF_DATA_RATE] > MAX_SPI_DATA_RATE:
+        raise cv.Invalid(
+            f"IWR6843 SPI supports at most {MAX_SPI_DATA_RATE / 1e6:.0f}MHz",
+            path=[CONF_DATA_RATE],
+        )
+    return config
+
+
+# Dwell-time Zone Schema
+ZONE_SCHEMA = BOUNDARY_SCHEMA.extend(
+    {
+        cv.Required(CONF_NAME): cv.string,
+    }
+)
+
 CONFIG_SCHEMA = (
     cv.Schema(
         {
@@ -65,17 +181,46 @@ CONFIG_SCHEMA = (
             cv.Optional(CONF_CEILING_HEIGHT, default=290): cv.int_range(
                 min=100, max=500
             ),
+            cv.Optional(CONF_MOUNTING, default={}): MOUNTING_SCHEMA,
             cv.Optional(CONF_MAX_TRACKS, default=5): cv.int_range(min=1, max=5),
             cv.Optional(CONF_TRACKING_BOUNDARY, default={}): BOUNDARY_SCHEMA,
             cv.Optional(CONF_PRESENCE_BOUNDARY, default={}): BOUNDARY_SCHEMA,
             cv.Optional(CONF_TRACKING_IDS, default=[]): cv.ensure_list(
                 TRACKING_ID_SCHEMA
             ),
+            cv.Optional(CONF_ZONES, default=[]): cv.All(
+                cv.ensure_list(ZONE_SCHEMA), cv.Length(max=MAX_ZONES)
+            ),
+            cv.Optional(
+                CONF_DIAGNOSTICS_INTERVAL, default="60s"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_HOT_PATH_LOGGING, default=False): cv.boolean,
+            cv.Optional(CONF_TRACE, default=False): cv.boolean,
+            cv.Optional(CONF_SPI_AUTO_TUNE): SPI_AUTO_TUNE_SCHEMA,
+            cv.Optional(CONF_ADAPTIVE_FRAME_RATE): ADAPTIVE_FRAME_RATE_SCHEMA,
+            cv.Optional(CONF_MAX_RECOVERY_ATTEMPTS, default=5): cv.int_range(
+                min=0, max=20
+            ),
+            cv.Optional(CONF_PUBLISH_BUDGET, default="2ms"): cv.All(
+                cv.positive_time_period_microseconds,
+                cv.Range(
+                    min=cv.TimePeriod(microseconds=100),
+                    max=cv.TimePeriod(milliseconds=20),
+                ),
+            ),
+            cv.Optional(CONF_CLUTTER_MAP): CLUTTER_MAP_SCHEMA,
+            cv.Optional(CONF_TRAJECTORY): TRAJECTORY_SCHEMA,
+            cv.Optional(CONF_ON_FRAME): automation.validate_automation(
+                {
+                    cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(FrameTrigger),
+                }
+            ),
         }
     )
     .extend(cv.COMPONENT_SCHEMA)
-    .extend(spi.spi_device_schema(cs_pin_required=True))
+    .extend(spi.spi_device_schema(cs_pin_required=True, default_data_rate=2e6))
     .extend(uart.UART_DEVICE_SCHEMA)
+    .add_extra(validate_data_rate)
 )
 
 
@@ -95,7 +240,63 @@ async def to_code(config):
 
     # Setup configuration
     cg.add(var.set_ceiling_height(config[CONF_CEILING_HEIGHT]))
+    mounting = config[CONF_MOUNTING]
+    cg.add(
+        var.set_mounting(
+            mounting[CONF_X],
+            mounting[CONF_Y],
+            mounting[CONF_YAW],
+            mounting[CONF_PITCH],
+            mounting[CONF_ROLL],
+        )
+    )
     cg.add(var.set_max_tracks(config[CONF_MAX_TRACKS]))
+    cg.add(var.set_diagnostics_interval(config[CONF_DIAGNOSTICS_INTERVAL]))
+    cg.add(var.set_max_recovery_attempts(config[CONF_MAX_RECOVERY_ATTEMPTS]))
+    cg.add(var.set_publish_budget(config[CONF_PUBLISH_BUDGET]))
+
+    # SPI clock (register_spi_device applies it to the bus device)
+    cg.add(var.set_spi_data_rate(int(config[CONF_DATA_RATE])))
+    if CONF_SPI_AUTO_TUNE in config:
+        cg.add(var.set_spi_auto_tune(True))
+        cg.add(
+            var.set_spi_max_data_rate(int(config[CONF_SPI_AUTO_TUNE][CONF_MAX_DATA_RATE]))
+        )
+
+    # Adaptive frame rate
+    if CONF_ADAPTIVE_FRAME_RATE in config:
+        adaptive = config[CONF_ADAPTIVE_FRAME_RATE]
+        cg.add(
+            var.set_adaptive_frame_rate(
+                adaptive[CONF_IDLE_TIMEOUT],
+                adaptive[CONF_IDLE_FRAME_PERIOD].total_milliseconds,
+            )
+        )
+
+    # Ghost track suppression
+    if CONF_CLUTTER_MAP in config:
+        clutter = config[CONF_CLUTTER_MAP]
+        cg.add(
+            var.set_clutter_map(
+                clutter[CONF_LEARNING_TIME],
+                clutter[CONF_THRESHOLD],
+            )
+        )
+
+    # Per-frame logging and binary tracing are compile-time options
+    if config[CONF_HOT_PATH_LOGGING]:
+        cg.add_define("USE_IWR6843_HOT_PATH_LOGGING")
+    if config[CONF_TRACE]:
+        cg.add_define("USE_IWR6843_TRACE")
+
+    # Trajectory history and its query endpoint
+    if CONF_TRAJECTORY in config:
+        trajectory = config[CONF_TRAJECTORY]
+        cg.add_define("USE_IWR6843_TRAJECTORY")
+        cg.add(var.set_trajectory_buffer_size(trajectory[CONF_BUFFER_SIZE]))
+        base = await cg.get_variable(trajectory[CONF_WEB_SERVER_BASE_ID])
+        handler = cg.new_Pvariable(trajectory[CONF_HANDLER_ID], var)
+        cg.add(base.add_handler(handler))
 
     # Tracking boundaries
     tracking = config[CONF_TRACKING_BOUNDARY]
@@ -133,3 +334,22 @@ async def to_code(config):
         track_name = track_config.get(CONF_NAME, f"Person {track_id}")
         cg.add(var.add_tracking_id(track_id, track_name))
 
+
+    # Dwell-time zones
+    for zone in config[CONF_ZONES]:
+        cg.add(
+            var.add_zone(
+                zone[CONF_NAME],
+                zone[CONF_X_MIN],
+                zone[CONF_X_MAX],
+                zone[CONF_Y_MIN],
+                zone[CONF_Y_MAX],
+                zone[CONF_Z_MIN],
+                zone[CONF_Z_MAX],
+            )
+        )
+
+    # Per-frame automations
+    for conf in config.get(CONF_ON_FRAME, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, [(RadarFrameConstRef, "frame")], conf)
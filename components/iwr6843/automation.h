@@ -0,0 +1,18 @@
+#pragma once
+
+#include "esphome/core/automation.h"
+#include "esphome/core/component.h"
+#include "iwr6843.h"
+
+namespace esphome {
+namespace iwr6843 {
+
+class FrameTrigger : public Trigger<const RadarFrame &> {
+ public:
+  explicit FrameTrigger(IWR6843Component *parent) {
+    parent->add_on_frame_callback([this](const RadarFrame &frame) { this->trigger(frame); });
+  }
+};
+
+}  // namespace iwr6843
+}  // namespace esphome
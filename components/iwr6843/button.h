@@ -14,7 +14,7 @@ class IWR6843ResetButton : public button::Button, public Component {
  protected:
   void press_action() override {
     if (this->parent_ != nullptr) {
-      this->parent_->reset_sensor();
+      this->parent_->recover();  // Non-blocking reset and reconfiguration
     }
   }
 
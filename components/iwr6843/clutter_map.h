@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace esphome {
+namespace iwr6843 {
+
+// Learned static-clutter map over the tracking boundary (x/y), used to drop ghost tracks.
+//
+// Each cell holds a score in [0, 1] that decays by frame_dt / learning_time per frame. A cell gains
+// the same amount when it holds points away from every track (fans, curtains). Tracks never raise a
+// score, so a person who stays put does not teach the map their own cell. A track is suppressed once
+// it is in a cell at or above the threshold without having moved from where it appeared (ghosts are
+// born in place, people walk in), and stays suppressed until it moves, so a ghost jittering across a
+// cell edge does not flicker onto a display ID. Positions are room frame.
+class ClutterMap {
+ public:
+  static const uint8_t GRID_SIZE = 32;               // Cells per axis
+  static const uint8_t MAX_ORIGINS = 32;             // Radar track IDs followed at once
+  static const uint8_t MAX_FRAME_TRACKS = 20;        // Tracker limit per frame
+  static constexpr float MOVE_RADIUS = 0.4f;         // m from the birth position that counts as moved
+  static constexpr float TRACK_EXCLUSION = 0.5f;     // m around tracks where points are not learned
+  static const uint32_t ORIGIN_TIMEOUT = 1000;       // ms unseen before a radar ID counts as a new track
+  static const uint32_t MAX_FRAME_GAP = 1000;        // ms, clamps learning/decay after an outage
+
+  using Cells = std::array<uint8_t, GRID_SIZE * GRID_SIZE>;  // Scores quantized for persistence
+
+  void set_area(float x_min, float x_max, float y_min, float y_max) {
+    this->x_min_ = x_min;
+    this->y_min_ = y_min;
+    this->scale_x_ = x_max > x_min ? GRID_SIZE / (x_max - x_min) : 0.0f;
+    this->scale_y_ = y_max > y_min ? GRID_SIZE / (y_max - y_min) : 0.0f;
+    this->reset();
+  }
+  void set_learning_time(uint32_t ms) { this->learning_time_ = ms; }
+  void set_threshold(float threshold) { this->threshold_ = threshold; }
+
+  void reset() {
+    this->scores_.fill(0.0f);
+    for (auto &origin : this->origins_) {
+      origin.active = false;
+    }
+    this->num_frame_tracks_ = 0;
+  }
+
+  // Called for every radar track before it gets a display ID; returns true to drop it
+  bool observe_track(uint8_t radar_id, float x, float y, uint32_t now_ms) {
+    Origin &origin = this->find_origin_(radar_id, now_ms);
+    if (!origin.active || origin.radar_id != radar_id || now_ms - origin.last_ms > ORIGIN_TIMEOUT) {
+      origin = Origin{true, radar_id, false, false, x, y, now_ms};
+    }
+    origin.last_ms = now_ms;
+    float dx = x - origin.x;
+    float dy = y - origin.y;
+    if (!origin.moved && dx * dx + dy * dy > MOVE_RADIUS * MOVE_RADIUS) {
+      origin.moved = true;
+    }
+
+    if (this->num_frame_tracks_ < MAX_FRAME_TRACKS) {
+      FrameTrack &track = this->frame_tracks_[this->num_frame_tracks_++];
+      track.x = x;
+      track.y = y;
+    }
+
+    bool suppress = !origin.moved && (origin.counted || this->score(x, y) >= this->threshold_);  // Sticky
+    if (suppress && !origin.counted) {
+      origin.counted = true;
+      this->suppressed_tracks_++;
+    }
+    return suppress;
+  }
+
+  // Called once per frame after all tracks were observed; O(cells + points * tracks)
+  void update(const float *x, const float *y, uint16_t num_points, uint32_t frame_dt) {
+    if (frame_dt > MAX_FRAME_GAP) {
+      frame_dt = MAX_FRAME_GAP;
+    }
+    float gain = std::min(1.0f, float(frame_dt) / float(this->learning_time_));
+    float keep = 1.0f - gain;
+    for (float &score : this->scores_) {
+      score *= keep;
+    }
+
+    // Points away from tracks: at most one gain per cell and frame
+    std::array<uint32_t, GRID_SIZE * GRID_SIZE / 32> hit{};
+    for (uint16_t i = 0; i < num_points; i++) {
+      int cell = this->cell_(x[i], y[i]);
+      if (cell < 0 || this->near_track_(x[i], y[i])) {
+        continue;
+      }
+      if ((hit[cell / 32] & (1u << (cell % 32))) == 0) {
+        hit[cell / 32] |= 1u << (cell % 32);
+        this->scores_[cell] = std::min(1.0f, this->scores_[cell] + gain);
+      }
+    }
+    this->num_frame_tracks_ = 0;
+  }
+
+  float score(float x, float y) const {
+    int cell = this->cell_(x, y);
+    return cell < 0 ? 0.0f : this->scores_[cell];
+  }
+
+  uint16_t clutter_cells() const {
+    return std::count_if(this->scores_.begin(), this->scores_.end(),
+                         [this](float score) { return score >= this->threshold_; });
+  }
+  uint32_t suppressed_tracks() const { return this->suppressed_tracks_; }
+
+  void save(Cells &cells) const {
+    for (size_t i = 0; i < cells.size(); i++) {
+      cells[i] = (uint8_t) (this->scores_[i] * 255.0f + 0.5f);
+    }
+  }
+  void load(const Cells &cells) {
+    for (size_t i = 0; i < cells.size(); i++) {
+      this->scores_[i] = cells[i] / 255.0f;
+    }
+  }
+
+ protected:
+  struct Origin {
+    bool active;
+    uint8_t radar_id;
+    bool moved;
+    bool counted;  // Suppressed (counted once); stays suppressed until it moves
+    float x;       // Birth position
+    float y;
+    uint32_t last_ms;
+  };
+
+  struct FrameTrack {
+    float x;
+    float y;
+  };
+
+  // Slot already following radar_id, else a free or expired one, else the least recently seen
+  Origin &find_origin_(uint8_t radar_id, uint32_t now_ms) {
+    Origin *oldest = &this->origins_[0];
+    for (auto &origin : this->origins_) {
+      if (origin.active && origin.radar_id == radar_id) {
+        return origin;
+      }
+      if (!origin.active || now_ms - origin.last_ms > now_ms - oldest->last_ms) {
+        oldest = &origin;
+        if (!origin.active) {
+          break;
+        }
+      }
+    }
+    return *oldest;
+  }
+
+  int cell_(float x, float y) const {
+    int cx = (int) ((x - this->x_min_) * this->scale_x_);
+    int cy = (int) ((y - this->y_min_) * this->scale_y_);
+    if (x < this->x_min_ || y < this->y_min_ || cx >= GRID_SIZE || cy >= GRID_SIZE) {
+      return -1;
+    }
+    return cy * GRID_SIZE + cx;
+  }
+
+  bool near_track_(float x, float y) const {
+    for (uint8_t i = 0; i < this->num_frame_tracks_; i++) {
+      float dx = x - this->frame_tracks_[i].x;
+      float dy = y - this->frame_tracks_[i].y;
+      if (dx * dx + dy * dy < TRACK_EXCLUSION * TRACK_EXCLUSION) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::array<float, GRID_SIZE * GRID_SIZE> scores_{};
+  std::array<Origin, MAX_ORIGINS> origins_{};
+  std::array<FrameTrack, MAX_FRAME_TRACKS> frame_tracks_{};
+  uint8_t num_frame_tracks_{0};
+  uint32_t suppressed_tracks_{0};
+  float x_min_{0.0f};
+  float y_min_{0.0f};
+  float scale_x_{0.0f};
+  float scale_y_{0.0f};
+  uint32_t learning_time_{600000};  // ms
+  float threshold_{0.5f};
+};
+
+}  // namespace iwr6843
+}  // namespace esphome
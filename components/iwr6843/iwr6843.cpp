@@ -1,5 +1,7 @@
 #include "iwr6843.h"
 #include "esphome/core/log.h"
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
 namespace esphome {
@@ -7,12 +9,26 @@ namespace iwr6843 {
 
 static const char *const TAG = "iwr6843";
 
+// Per-frame logs are compiled out unless `hot_path_logging: true`; use `trace: true` for cheap production tracing
+#ifdef USE_IWR6843_HOT_PATH_LOGGING
+#define IWR6843_HOT_LOGD(...) ESP_LOGD(TAG, __VA_ARGS__)
+#define IWR6843_HOT_LOGV(...) ESP_LOGV(TAG, __VA_ARGS__)
+#else
+#define IWR6843_HOT_LOGD(...) \
+  do { \
+  } while (0)
+#define IWR6843_HOT_LOGV(...) \
+  do { \
+  } while (0)
+#endif
+
 void IWR6843Component::setup() {
   ESP_LOGCONFIG(TAG, "Setting up IWR6843...");
 
   // Initialize SPI interface
   this->spi_setup();
-  ESP_LOGCONFIG(TAG, "SPI interface initialized");
+  this->spi_buffer_.reserve(MAX_FRAME_SIZE);
+  ESP_LOGCONFIG(TAG, "SPI interface initialized at %u Hz", this->spi_data_rate_);
   
   // Initialize SOP2 pin (functional mode)
   if (this->sop2_pin_ != nullptr) {
@@ -32,9 +48,38 @@ void IWR6843Component::setup() {
   this->reset_sensor();
   delay(500);
 
+  // Mounting pose first: sensorPosition and the boundaries sent to the radar depend on it
+  this->apply_mounting_pose_();
+
   // Initialize sensor configuration via UART
   this->initialize_sensor_config_();
 
+  // Clutter map over the tracking boundary; a different boundary gets a fresh map
+  if (this->clutter_map_enabled_) {
+    const BoundaryBox &box = this->tracking_boundary_;
+    this->clutter_map_.set_area(box.x_min, box.x_max, box.y_min, box.y_max);
+    uint32_t hash = fnv1_hash(str_sprintf("iwr6843_clutter %.2f %.2f %.2f %.2f", box.x_min, box.x_max, box.y_min,
+                                          box.y_max));
+    this->clutter_pref_ = global_preferences->make_preference<ClutterMap::Cells>(hash);
+    ClutterMap::Cells cells;
+    if (this->clutter_pref_.load(&cells)) {
+      this->clutter_map_.load(cells);
+      ESP_LOGCONFIG(TAG, "Clutter map restored (%u cells)", this->clutter_map_.clutter_cells());
+    }
+    this->set_interval("clutter_save", CLUTTER_SAVE_INTERVAL, [this]() { this->save_clutter_map_(); });
+  }
+
+#ifdef USE_IWR6843_TRAJECTORY
+  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  uint8_t *trajectory_buffer = allocator.allocate(this->trajectory_buffer_size_);
+  if (trajectory_buffer == nullptr || !this->trajectory_.init(trajectory_buffer, this->trajectory_buffer_size_)) {
+    ESP_LOGE(TAG, "Could not allocate %u bytes for trajectory history", this->trajectory_buffer_size_);
+  }
+#endif
+
+  this->last_activity_time_ = millis();
+  this->last_frame_time_ = this->last_activity_time_;  // Supervisor grace period starts now
+  this->publish_diagnostic_(LINK_STATE, this->link_state_);  // Initial state; then once per transition
   ESP_LOGCONFIG(TAG, "IWR6843 setup complete");
 }
 
@@ -49,38 +94,46 @@ void IWR6843Component::loop() {
     last_debug_time = current_time;
   }
   
-  // Read frame from SPI
-  if (this->find_magic_word_spi_()) {
-    ESP_LOGD(TAG, "Magic word found!");
-    FrameHeader header;
-    if (this->read_frame_header_(header)) {
-      ESP_LOGD(TAG, "Frame header read: frame=%u, length=%u, tlvs=%u", 
-               header.frame_number, header.total_packet_len, header.num_tlvs);
-      if (this->read_frame_data_(header)) {
-        this->frame_count_++;
-        this->update_sensors_();
-        ESP_LOGD(TAG, "Frame %u processed successfully", this->frame_count_);
-        
-        // Cleanup old tracks every 50 frames
-        if (this->frame_count_ % 50 == 0) {
-          this->cleanup_old_tracks_();
-        }
-      }
+  // Non-blocking reconfiguration (link recovery, frame-rate switches)
+  this->pump_config_queue_(current_time);
+
+  // Read frame from SPI (backed off while the radar is silent)
+  bool frame_processed = false;
+  if (this->should_poll_(current_time)) {
+    frame_processed = this->read_frame_();
+    if (!frame_processed && this->link_state_ != LINK_STREAMING) {
+      this->poll_interval_ = std::min(std::max(this->poll_interval_ * 2, POLL_BACKOFF_MIN), POLL_BACKOFF_MAX);
+      this->next_poll_time_ = current_time + this->poll_interval_;
     }
   }
 
-  // Reset all tracks to 0 if no valid frames received for 2 seconds
-  if (current_time - this->last_frame_time_ > 2000) {
-    for (auto &pair : this->tracks_) {
-      this->reset_track_data_(pair.first);
-    }
-    this->update_sensors_();
+  this->supervise_link_(current_time, frame_processed);
+
+  // Publish pending entity updates within the per-pass budget
+  this->drain_publish_queue_();
+
+  // Slow the radar down when the room is empty, back to full rate on the first track
+  if (frame_processed && this->adaptive_frame_rate_) {
+    this->update_frame_rate_(millis());
+  }
+
+  // Periodic summary/diagnostic export
+  if (current_time - this->last_diagnostics_time_ >= this->diagnostics_interval_) {
+    this->publish_diagnostics_();
+    this->last_diagnostics_time_ = current_time;
+  }
+
+  // Drain a few trace records on passes without frame work
+  if (!frame_processed) {
+    this->drain_trace_(TRACE_DRAIN_PER_LOOP);
   }
 }
 
 void IWR6843Component::dump_config() {
   ESP_LOGCONFIG(TAG, "IWR6843 mmWave Radar:");
   ESP_LOGCONFIG(TAG, "  Ceiling Height: %d cm", this->ceiling_height_);
+  ESP_LOGCONFIG(TAG, "  Mounting: X %.2f m, Y %.2f m, yaw %.1f°, pitch %.1f°, roll %.1f°", this->mounting_x_,
+                this->mounting_y_, this->mounting_yaw_, this->mounting_pitch_, this->mounting_roll_);
   ESP_LOGCONFIG(TAG, "  Max Tracks: %d", this->max_tracks_);
   ESP_LOGCONFIG(TAG, "  Tracking Boundary: X[%.1f, %.1f] Y[%.1f, %.1f] Z[%.1f, %.1f]",
                 this->tracking_boundary_.x_min, this->tracking_boundary_.x_max,
@@ -90,12 +143,48 @@ void IWR6843Component::dump_config() {
                 this->presence_boundary_.x_min, this->presence_boundary_.x_max,
                 this->presence_boundary_.y_min, this->presence_boundary_.y_max,
                 this->presence_boundary_.z_min, this->presence_boundary_.z_max);
+  if (this->adaptive_frame_rate_) {
+    ESP_LOGCONFIG(TAG, "  Adaptive Frame Rate: %.0f ms active, %.0f ms after %u s idle", ACTIVE_FRAME_PERIOD,
+                  this->idle_frame_period_, this->idle_timeout_ / 1000);
+  }
+  ESP_LOGCONFIG(TAG, "  Max Recovery Attempts: %u", this->max_recovery_attempts_);
+  ESP_LOGCONFIG(TAG, "  Publish Budget: %u us", this->publish_budget_);
+  if (this->clutter_map_enabled_) {
+    ESP_LOGCONFIG(TAG, "  Clutter Map: %ux%u cells, %u learned", ClutterMap::GRID_SIZE, ClutterMap::GRID_SIZE,
+                  this->clutter_map_.clutter_cells());
+  }
+#ifdef USE_IWR6843_TRAJECTORY
+  ESP_LOGCONFIG(TAG, "  Trajectory history: %u bytes", this->trajectory_.capacity());
+#endif
+  ESP_LOGCONFIG(TAG, "  SPI Data Rate: %u Hz (auto-tune: %s, max %u Hz)", this->spi_data_rate_,
+                YESNO(this->spi_auto_tune_), this->spi_max_data_rate_);
+#ifdef USE_IWR6843_HOT_PATH_LOGGING
+  ESP_LOGCONFIG(TAG, "  Hot-path logging: enabled");
+#endif
+#ifdef USE_IWR6843_TRACE
+  ESP_LOGCONFIG(TAG, "  Trace buffer: %u records", TRACE_BUFFER_SIZE);
+#endif
+  ESP_LOGCONFIG(TAG, "  Heatmap: %ux%u cells, diagnostics every %u ms", HEATMAP_GRID_SIZE, HEATMAP_GRID_SIZE,
+                this->diagnostics_interval_);
+  for (uint8_t i = 0; i < this->num_zones_; i++) {
+    const Zone &zone = this->zones_[i];
+    ESP_LOGCONFIG(TAG, "  Zone '%s': X[%.1f, %.1f] Y[%.1f, %.1f] Z[%.1f, %.1f]", zone.name.c_str(),
+                  zone.box.x_min, zone.box.x_max, zone.box.y_min, zone.box.y_max, zone.box.z_min, zone.box.z_max);
+  }
+}
+
+void IWR6843Component::on_safe_shutdown() {
+  if (this->clutter_map_enabled_) {
+    this->save_clutter_map_();
+  }
 }
 
 // Configuration functions
 void IWR6843Component::set_tracking_boundary(float x_min, float x_max, float y_min, float y_max, float z_min,
                                               float z_max) {
   this->tracking_boundary_ = {x_min, x_max, y_min, y_max, z_min, z_max};
+  // Heatmap cells are fractions of this box; time counted over the old box would land in the wrong places
+  this->reset_heatmap();
 }
 
 void IWR6843Component::set_presence_boundary(float x_min, float x_max, float y_min, float y_max, float z_min,
@@ -111,10 +200,43 @@ void IWR6843Component::add_tracking_id(uint8_t id, const std::string &name) {
   track.id = id;
   track.is_present = false;
   track.is_fallen = false;
-  track.last_seen = 0;
+  track.last_seen = UINT32_MAX;  // Never seen: frame 0 must not count as an update
   this->tracks_[id] = track;
 }
 
+void IWR6843Component::add_zone(const std::string &name, float x_min, float x_max, float y_min, float y_max,
+                                float z_min, float z_max) {
+  if (this->num_zones_ >= MAX_ZONES) {
+    ESP_LOGW(TAG, "Zone '%s' ignored, at most %u zones supported", name.c_str(), MAX_ZONES);
+    return;
+  }
+
+  Zone &zone = this->zones_[this->num_zones_++];
+  zone.name = name;
+  zone.box = {x_min, x_max, y_min, y_max, z_min, z_max};
+  zone.dwell_ms = 0;
+}
+
+void IWR6843Component::reset_clutter_map() {
+  this->clutter_map_.reset();
+  if (this->clutter_map_enabled_) {
+    this->save_clutter_map_();
+  }
+}
+
+void IWR6843Component::save_clutter_map_() {
+  ClutterMap::Cells cells;
+  this->clutter_map_.save(cells);
+  this->clutter_pref_.save(&cells);
+}
+
+void IWR6843Component::reset_heatmap() {
+  this->heatmap_.fill(0);
+  for (uint8_t i = 0; i < this->num_zones_; i++) {
+    this->zones_[i].dwell_ms = 0;
+  }
+}
+
 // Sensor registration
 void IWR6843Component::register_presence_sensor(uint8_t id, binary_sensor::BinarySensor *sensor) {
   this->presence_sensors_[id] = sensor;
@@ -140,6 +262,18 @@ void IWR6843Component::register_z_coordinate_sensor(uint8_t id, sensor::Sensor *
   this->z_coordinate_sensors_[id] = sensor;
 }
 
+void IWR6843Component::register_height_sensor(uint8_t id, sensor::Sensor *sensor) {
+  this->height_sensors_[id] = sensor;
+}
+
+void IWR6843Component::register_zone_dwell_sensor(const std::string &zone, sensor::Sensor *sensor) {
+  this->zone_dwell_sensors_[zone] = sensor;
+}
+
+void IWR6843Component::register_diagnostic_sensor(DiagnosticType type, sensor::Sensor *sensor) {
+  this->diagnostic_sensors_[type] = sensor;
+}
+
 // Control functions
 void IWR6843Component::reset_sensor() {
   if (this->nrst_pin_ == nullptr)
@@ -161,17 +295,62 @@ void IWR6843Component::set_flash_mode(bool enable) {
   ESP_LOGI(TAG, "Flash mode: %s", enable ? "enabled" : "disabled");
 }
 
-// UART communication
-void IWR6843Component::send_uart_command_(const std::string &command) {
-  if (!this->available()) {
-    ESP_LOGW(TAG, "UART not available for command: %s", command.c_str());
-    return;
+// Tracing
+void IWR6843Component::dump_trace() {
+#ifdef USE_IWR6843_TRACE
+  ESP_LOGI(TAG, "Trace: %u records buffered, %u dropped", this->trace_count_, this->trace_dropped_);
+  this->drain_trace_(TRACE_BUFFER_SIZE);
+#else
+  ESP_LOGW(TAG, "Trace buffer not enabled (set `trace: true`)");
+#endif
+}
+
+void IWR6843Component::drain_trace_(size_t max_records) {
+#ifdef USE_IWR6843_TRACE
+  while (max_records-- > 0 && this->trace_count_ > 0) {
+    const TraceRecord &r = this->trace_buffer_[this->trace_head_];
+    this->trace_head_ = (this->trace_head_ + 1) & (TRACE_BUFFER_SIZE - 1);
+    this->trace_count_--;
+
+    switch (r.event) {
+      case TRACE_MAGIC_FOUND:
+        ESP_LOGD(TAG, "[%u] magic word after %u bytes", r.timestamp, r.args[0]);
+        break;
+      case TRACE_FRAME_HEADER:
+        ESP_LOGD(TAG, "[%u] header frame=%u length=%u tlvs=%u", r.timestamp, r.args[0], r.args[1], r.args[2]);
+        break;
+      case TRACE_FRAME_PROCESSED:
+        ESP_LOGD(TAG, "[%u] frame %u processed in %u us", r.timestamp, r.args[0], r.args[1]);
+        break;
+      case TRACE_TRACK:
+        ESP_LOGD(TAG, "[%u] track %u (radar %u) X=%d Y=%d Z=%d cm Vel=%d mm/s present=%u fallen=%u", r.timestamp,
+                 (r.args[0] >> 16) & 0xFF, (r.args[0] >> 8) & 0xFF, (int16_t) (r.args[1] >> 16),
+                 (int16_t) r.args[1], (int16_t) (r.args[2] >> 16), (int16_t) r.args[2], (r.args[0] >> 1) & 1,
+                 r.args[0] & 1);
+        break;
+      case TRACE_INVALID_LENGTH:
+        ESP_LOGD(TAG, "[%u] invalid frame length %u", r.timestamp, r.args[0]);
+        break;
+      default:
+        ESP_LOGD(TAG, "[%u] event %u: %u %u %u", r.timestamp, r.event, r.args[0], r.args[1], r.args[2]);
+        break;
+    }
   }
+#else
+  (void) max_records;
+#endif
+}
 
+// UART communication
+void IWR6843Component::write_uart_command_(const std::string &command) {
   ESP_LOGD(TAG, "Sending UART command: %s", command.c_str());
   this->write_str(command.c_str());
   uart::UARTDevice::write_byte('\n');  // Explicitly use UART write_byte
-  delay(50);  // Wait for command processing
+}
+
+void IWR6843Component::send_uart_command_(const std::string &command) {
+  this->write_uart_command_(command);
+  delay(CONFIG_COMMAND_SPACING);  // Wait for command processing
 }
 
 void IWR6843Component::send_config_update(const std::string &command) {
@@ -192,103 +371,424 @@ void IWR6843Component::send_config_update(const std::string &command) {
   ESP_LOGI(TAG, "Configuration updated successfully");
 }
 
-void IWR6843Component::initialize_sensor_config_() {
-  ESP_LOGI(TAG, "Initializing sensor configuration...");
-  
-  // Send initial configuration commands
-  this->send_uart_command_("sensorStop");
-  delay(200);
-  
-  this->send_uart_command_("flushCfg");
-  delay(100);
+void IWR6843Component::build_sensor_config_(std::vector<ConfigCommand> &commands) {
+  // Full configuration restarts at full frame rate
+  this->close_mode_interval_(millis());
+  this->frame_period_ = ACTIVE_FRAME_PERIOD;
+  this->idle_mode_ = false;
+  this->pending_frame_period_ = 0.0f;
+  this->reconfig_start_time_ = 0;
+
+  char cmd[256];
+  commands.clear();
+  commands.push_back({"sensorStop", 200});
+  commands.push_back({"flushCfg", 100});
   
   // Send all configuration commands
-  this->send_uart_command_("dfeDataOutputMode 1");
-  this->send_uart_command_("channelCfg 15 7 0");
-  this->send_uart_command_("adcCfg 2 1");
-  this->send_uart_command_("adcbufCfg -1 0 1 1 1");
-  this->send_uart_command_("lowPower 0 0");
+  commands.push_back({"dfeDataOutputMode 1", 0});
+  commands.push_back({"channelCfg 15 7 0", 0});
+  commands.push_back({"adcCfg 2 1", 0});
+  commands.push_back({"adcbufCfg -1 0 1 1 1", 0});
+  commands.push_back({"lowPower 0 0", 0});
   
   // Chirp configuration
-  this->send_uart_command_("chirpCfg 0 0 0 0 0 0 0 1");
-  this->send_uart_command_("chirpCfg 1 1 0 0 0 0 0 2");
-  this->send_uart_command_("chirpCfg 2 2 0 0 0 0 0 4");
+  commands.push_back({"chirpCfg 0 0 0 0 0 0 0 1", 0});
+  commands.push_back({"chirpCfg 1 1 0 0 0 0 0 2", 0});
+  commands.push_back({"chirpCfg 2 2 0 0 0 0 0 4", 0});
   
   // Frame configuration
-  this->send_uart_command_("frameCfg 0 2 224 0 120.00 1 0");
+  commands.push_back({this->frame_cfg_command_(this->frame_period_), 0});
   
   // CFAR configuration
-  this->send_uart_command_("dynamicRACfarCfg -1 10 1 1 1 8 8 6 4 4.00 6.00 0.50 1 1");
-  this->send_uart_command_("staticRACfarCfg -1 4 4 2 2 8 16 4 6 6.00 13.00 0.50 0 0");
+  commands.push_back({"dynamicRACfarCfg -1 10 1 1 1 8 8 6 4 4.00 6.00 0.50 1 1", 0});
+  commands.push_back({"staticRACfarCfg -1 4 4 2 2 8 16 4 6 6.00 13.00 0.50 0 0", 0});
   
   // Angle configuration
-  this->send_uart_command_("dynamicRangeAngleCfg -1 7.000 0.0010 2 0");
-  this->send_uart_command_("dynamic2DAngleCfg -1 5 1 1 1.00 15.00 2");
-  this->send_uart_command_("staticRangeAngleCfg -1 0 1 1");
+  commands.push_back({"dynamicRangeAngleCfg -1 7.000 0.0010 2 0", 0});
+  commands.push_back({"dynamic2DAngleCfg -1 5 1 1 1.00 15.00 2", 0});
+  commands.push_back({"staticRangeAngleCfg -1 0 1 1", 0});
   
   // Antenna geometry
-  this->send_uart_command_("antGeometry0 -1 -1 0 0 -3 -3 -2 -2 -1 -1 0 0");
-  this->send_uart_command_("antGeometry1 -1 0 -1 0 -3 -2 -3 -2 -3 -2 -3 -2");
-  this->send_uart_command_("antPhaseRot 1 -1 1 -1 1 -1 1 -1 1 -1 1 -1");
+  commands.push_back({"antGeometry0 -1 -1 0 0 -3 -3 -2 -2 -1 -1 0 0", 0});
+  commands.push_back({"antGeometry1 -1 0 -1 0 -3 -2 -3 -2 -3 -2 -3 -2", 0});
+  commands.push_back({"antPhaseRot 1 -1 1 -1 1 -1 1 -1 1 -1 1 -1", 0});
   
   // FOV configuration
-  this->send_uart_command_("fovCfg -1 64.0 64.0");
-  this->send_uart_command_("compRangeBiasAndRxChanPhase 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0");
+  commands.push_back({"fovCfg -1 64.0 64.0", 0});
+  commands.push_back({"compRangeBiasAndRxChanPhase 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0", 0});
   
-  // Boundaries (use configured values)
-  char boundary_cmd[256];
-  snprintf(boundary_cmd, sizeof(boundary_cmd), "boundaryBox %.1f %.1f %.1f %.1f %.1f %.1f",
-           this->tracking_boundary_.x_min, this->tracking_boundary_.x_max,
-           this->tracking_boundary_.y_min, this->tracking_boundary_.y_max,
-           this->tracking_boundary_.z_min, this->tracking_boundary_.z_max);
-  this->send_uart_command_(boundary_cmd);
-  
-  snprintf(boundary_cmd, sizeof(boundary_cmd), "presenceBoundaryBox %.1f %.1f %.1f %.1f %.1f %.1f",
-           this->presence_boundary_.x_min, this->presence_boundary_.x_max,
-           this->presence_boundary_.y_min, this->presence_boundary_.y_max,
-           this->presence_boundary_.z_min, this->presence_boundary_.z_max);
-  this->send_uart_command_(boundary_cmd);
-  
-  // Sensor position (ceiling height in meters, 90° tilt)
-  float height_m = this->ceiling_height_ / 100.0f;
-  char sensor_pos_cmd[64];
-  snprintf(sensor_pos_cmd, sizeof(sensor_pos_cmd), "sensorPosition %.1f 0 90", height_m);
-  this->send_uart_command_(sensor_pos_cmd);
+  // Boundaries (configured in the room frame, sent in the tracker frame)
+  commands.push_back({this->boundary_command_("boundaryBox", this->tracking_boundary_), 0});
+  commands.push_back({this->boundary_command_("presenceBoundaryBox", this->presence_boundary_), 0});
+
+  // Sensor position (mounting height and downward tilt)
+  commands.push_back({this->sensor_position_command_(), 0});
   
   // Tracking configuration
-  this->send_uart_command_("gatingParam 3 2 2 3 4");
-  this->send_uart_command_("stateParam 3 3 6 20 3 1000");
-  char alloc_cmd[64];
-  snprintf(alloc_cmd, sizeof(alloc_cmd), "allocationParam %d %d 0.05 %d 1.5 %d",
+  commands.push_back({"gatingParam 3 2 2 3 4", 0});
+  commands.push_back({"stateParam 3 3 6 20 3 1000", 0});
+  snprintf(cmd, sizeof(cmd), "allocationParam %d %d 0.05 %d 1.5 %d",
            this->max_tracks_, this->max_tracks_, this->max_tracks_, this->max_tracks_);
-  this->send_uart_command_(alloc_cmd);
-  this->send_uart_command_("maxAcceleration 1 0.1 1");
-  this->send_uart_command_("trackingCfg 1 4 800 20 37 33 120 1");
+  commands.push_back({cmd, 0});
+  commands.push_back({"maxAcceleration 1 0.1 1", 0});
+  commands.push_back({this->tracking_cfg_command_(this->frame_period_), 200});
   
   // Start sensor
-  delay(200);
-  this->send_uart_command_("sensorStart");
-  delay(500);
+  commands.push_back({"sensorStart", 500});
+}
+
+void IWR6843Component::initialize_sensor_config_() {
+  ESP_LOGI(TAG, "Initializing sensor configuration...");
+
+  std::vector<ConfigCommand> commands;
+  this->build_sensor_config_(commands);
+  for (const auto &command : commands) {
+    this->send_uart_command_(command.command);
+    delay(command.extra_delay);
+  }
   
   ESP_LOGI(TAG, "Sensor configuration complete");
 }
 
-void IWR6843Component::update_boundary_config_(const std::string &boundary_type) {
-  char cmd[256];
-  
+void IWR6843Component::pump_config_queue_(uint32_t now) {
+  // One queued command per call, spaced like the blocking path
+  if (this->config_queue_pos_ >= this->config_queue_.size() || (int32_t) (now - this->next_config_time_) < 0) {
+    return;
+  }
+
+  const ConfigCommand &command = this->config_queue_[this->config_queue_pos_++];
+  this->write_uart_command_(command.command);
+  this->next_config_time_ = now + CONFIG_COMMAND_SPACING + command.extra_delay;
+  if (command.command == "sensorStart") {
+    this->last_frame_time_ = now;  // The supervisor's grace period restarts with the radar
+    if (this->pending_frame_period_ > 0.0f) {
+      // The new period is live from here
+      this->frame_period_ = this->pending_frame_period_;
+      this->pending_frame_period_ = 0.0f;
+      this->reconfig_start_time_ = now;
+    }
+  }
+
+  if (this->config_queue_pos_ == this->config_queue_.size()) {
+    ESP_LOGI(TAG, "Sensor configuration pushed (%u commands)", this->config_queue_.size());
+    this->config_queue_.clear();
+    this->config_queue_pos_ = 0;
+    if (this->link_state_ == LINK_RECOVERING) {
+      // Give the radar time to start streaming before declaring the attempt failed
+      this->recovery_deadline_ = this->next_config_time_ + LINK_RECOVERY_TIMEOUT;
+    }
+  }
+}
+
+// Link supervisor
+void IWR6843Component::recover() {
+  // A manual reset is not an outage: MTTR only counts outages the supervisor took to lost
+  this->recovery_attempts_ = 0;
+  this->start_recovery_(millis());
+}
+
+bool IWR6843Component::should_poll_(uint32_t now) {
+  if (this->link_state_ == LINK_RECOVERING && this->recovery_deadline_ == 0) {
+    return false;  // Radar in reset or being reconfigured
+  }
+  return this->link_state_ == LINK_STREAMING || (int32_t) (now - this->next_poll_time_) >= 0;
+}
+
+void IWR6843Component::supervise_link_(uint32_t now, bool frame_processed) {
+  if (frame_processed) {
+    if (this->link_state_ != LINK_STREAMING) {
+      if (this->outage_lost_) {
+        this->recoveries_++;
+        this->total_recovery_ms_ += now - this->outage_start_;
+        ESP_LOGI(TAG, "Radar link recovered after %u ms", now - this->outage_start_);
+      }
+      this->outage_lost_ = false;
+      this->recovery_attempts_ = 0;
+      this->poll_interval_ = 0;
+      this->set_link_state_(LINK_STREAMING, now);
+    }
+    return;
+  }
+
+  uint32_t silent = now - this->last_frame_time_;
+  uint32_t degraded_after = LINK_DEGRADED_FRAMES * this->frame_period_;
+
+  switch (this->link_state_) {
+    case LINK_STREAMING:
+      if (silent > degraded_after && this->config_queue_.empty()) {  // Not stopped for a queued push
+        this->outage_start_ = this->last_frame_time_;
+        this->poll_interval_ = POLL_BACKOFF_MIN;
+        this->next_poll_time_ = now + this->poll_interval_;
+        this->set_link_state_(LINK_DEGRADED, now);
+      }
+      break;
+
+    case LINK_DEGRADED:
+      if (silent > degraded_after + LINK_LOST_TIMEOUT) {
+        this->outage_lost_ = true;
+        this->set_link_state_(LINK_LOST, now);
+      }
+      break;
+
+    case LINK_LOST:
+      // Reset with exponential spacing between attempts, up to the retry limit
+      if (this->recovery_attempts_ < this->max_recovery_attempts_ &&
+          now - this->link_state_since_ > (LINK_RECOVERY_DELAY << std::min<uint8_t>(this->recovery_attempts_, 4))) {
+        this->start_recovery_(now);
+      }
+      break;
+
+    case LINK_RECOVERING:
+      if (this->recovery_deadline_ != 0 && (int32_t) (now - this->recovery_deadline_) >= 0) {
+        ESP_LOGW(TAG, "Recovery attempt %u/%u failed", this->recovery_attempts_, this->max_recovery_attempts_);
+        if (this->recovery_attempts_ >= this->max_recovery_attempts_) {
+          ESP_LOGE(TAG, "Radar unresponsive, automatic recovery stopped (press reset to retry)");
+        }
+        this->poll_interval_ = POLL_BACKOFF_MAX;
+        this->set_link_state_(LINK_LOST, now);
+      }
+      break;
+  }
+}
+
+void IWR6843Component::set_link_state_(LinkState state, uint32_t now) {
+  static const char *const NAMES[] = {"streaming", "degraded", "lost", "recovering"};
+  ESP_LOGI(TAG, "Radar link %s -> %s", NAMES[this->link_state_], NAMES[state]);
+  if ((state == LINK_LOST || state == LINK_RECOVERING) && this->link_state_ != LINK_LOST) {
+    // No frames are coming: clear all tracks once, instead of republishing zeros on every pass. Covers the
+    // reset button too, which goes to recovering straight from streaming
+    for (auto &pair : this->tracks_) {
+      this->reset_track_data_(pair.first);
+    }
+  }
+  this->link_state_ = state;
+  this->link_state_since_ = now;
+
+  // Published once per transition
+  this->publish_diagnostic_(LINK_STATE, state);
+  if (state == LINK_STREAMING && this->recoveries_ > 0) {
+    this->publish_diagnostic_(MEAN_TIME_TO_RECOVERY, this->total_recovery_ms_ / 1000.0f / this->recoveries_);
+  }
+}
+
+void IWR6843Component::start_recovery_(uint32_t now) {
+  this->recovery_attempts_++;
+  this->recovery_deadline_ = 0;
+  this->set_link_state_(LINK_RECOVERING, now);
+  ESP_LOGW(TAG, "Recovering radar link (attempt %u/%u)", this->recovery_attempts_, this->max_recovery_attempts_);
+
+  if (this->nrst_pin_ == nullptr) {
+    this->build_sensor_config_(this->config_queue_);
+    this->config_queue_pos_ = 0;
+    this->next_config_time_ = now;
+    return;
+  }
+
+  // Pulse NRST and wait for boot without blocking loop()
+  this->nrst_pin_->digital_write(false);
+  this->set_timeout("link_recovery", 100, [this]() {
+    this->nrst_pin_->digital_write(true);
+    this->set_timeout("link_recovery", 500, [this]() {
+      this->build_sensor_config_(this->config_queue_);
+      this->config_queue_pos_ = 0;
+      this->next_config_time_ = millis();
+    });
+  });
+}
+
+void IWR6843Component::update_boundary_config(const std::string &boundary_type) {
+  std::string command;
   if (boundary_type == "tracking") {
-    snprintf(cmd, sizeof(cmd), "boundaryBox %.1f %.1f %.1f %.1f %.1f %.1f",
-             this->tracking_boundary_.x_min, this->tracking_boundary_.x_max,
-             this->tracking_boundary_.y_min, this->tracking_boundary_.y_max,
-             this->tracking_boundary_.z_min, this->tracking_boundary_.z_max);
+    command = this->boundary_command_("boundaryBox", this->tracking_boundary_);
   } else if (boundary_type == "presence") {
-    snprintf(cmd, sizeof(cmd), "presenceBoundaryBox %.1f %.1f %.1f %.1f %.1f %.1f",
-             this->presence_boundary_.x_min, this->presence_boundary_.x_max,
-             this->presence_boundary_.y_min, this->presence_boundary_.y_max,
-             this->presence_boundary_.z_min, this->presence_boundary_.z_max);
+    command = this->boundary_command_("presenceBoundaryBox", this->presence_boundary_);
+  } else {
+    return;
   }
-  
-  this->send_config_update(cmd);
+  if (this->link_state_ == LINK_RECOVERING && this->recovery_deadline_ == 0 && this->config_queue_.empty()) {
+    return;  // Radar in reset; the configuration built after boot carries the new box
+  }
+  ESP_LOGI(TAG, "Updating configuration: %s", command.c_str());
+
+  // Queued like a frame-rate switch so loop() never blocks; appended if another push is in flight
+  if (this->config_queue_.empty()) {
+    this->config_queue_pos_ = 0;
+    this->next_config_time_ = millis();
+  }
+  this->config_queue_.push_back({"sensorStop", 100});
+  this->config_queue_.push_back({command, 100});
+  this->config_queue_.push_back({"sensorStart", 0});
+}
+
+// Mounting
+void IWR6843Component::apply_mounting_pose_() {
+  this->mounting_.set_pose(this->mounting_x_, this->mounting_y_, this->ceiling_height_ / 100.0f, this->mounting_yaw_,
+                           this->mounting_pitch_, this->mounting_roll_);
+}
+
+void IWR6843Component::update_mounting() {
+  this->apply_mounting_pose_();
+  ESP_LOGI(TAG, "Updating mounting: height %u cm, pitch %.1f°", this->ceiling_height_, this->mounting_pitch_);
+
+  // Position and both boundaries change together; one stop/start for all three
+  this->send_uart_command_("sensorStop");
+  delay(100);
+  this->send_uart_command_(this->sensor_position_command_());
+  this->send_uart_command_(this->boundary_command_("boundaryBox", this->tracking_boundary_));
+  this->send_uart_command_(this->boundary_command_("presenceBoundaryBox", this->presence_boundary_));
+  delay(100);
+  this->send_uart_command_("sensorStart");
+  delay(200);
+  this->last_frame_time_ = millis();  // Reconfiguration gap is not a link loss
+}
+
+std::string IWR6843Component::frame_cfg_command_(float period) const {
+  return str_sprintf("frameCfg 0 2 224 0 %.2f 1 0", period);
+}
+
+std::string IWR6843Component::tracking_cfg_command_(float period) const {
+  // Seventh argument is the frame period (ms) the tracker predicts over
+  return str_sprintf("trackingCfg 1 4 800 20 37 33 %.0f 1", period);
+}
+
+std::string IWR6843Component::sensor_position_command_() const {
+  // Yaw, roll and the x/y offset are applied here; the radar only models height and downward tilt
+  return str_sprintf("sensorPosition %.2f 0 %.1f", this->ceiling_height_ / 100.0f, this->mounting_pitch_);
+}
+
+std::string IWR6843Component::boundary_command_(const char *name, const BoundaryBox &box) const {
+  // Axis-aligned hull of the room box in the tracker frame; tracks are filtered exactly in the room frame
+  float lo[3] = {INFINITY, INFINITY, INFINITY};
+  float hi[3] = {-INFINITY, -INFINITY, -INFINITY};
+  for (uint8_t corner = 0; corner < 8; corner++) {
+    float p[3] = {corner & 1 ? box.x_max : box.x_min, corner & 2 ? box.y_max : box.y_min,
+                  corner & 4 ? box.z_max : box.z_min};
+    this->mounting_.room_to_tracker(p[0], p[1], p[2]);
+    for (uint8_t axis = 0; axis < 3; axis++) {
+      lo[axis] = std::min(lo[axis], p[axis]);
+      hi[axis] = std::max(hi[axis], p[axis]);
+    }
+  }
+  return str_sprintf("%s %.2f %.2f %.2f %.2f %.2f %.2f", name, lo[0], hi[0], lo[1], hi[1], lo[2], hi[2]);
+}
+
+bool IWR6843Component::read_frame_() {
+  bool frame_processed = false;
+  if (this->find_magic_word_spi_()) {
+    int64_t received_us = this->micros64_();
+    IWR6843_HOT_LOGD("Magic word found!");
+    FrameHeader header;
+    if (this->read_frame_header_(header)) {
+      IWR6843_HOT_LOGD("Frame header read: frame=%u, length=%u, tlvs=%u", header.frame_number,
+                       header.total_packet_len, header.num_tlvs);
+      this->trace_(TRACE_FRAME_HEADER, header.frame_number, header.total_packet_len, header.num_tlvs);
+      uint32_t previous_frame_time = this->last_frame_time_;
+      uint32_t parse_start = micros();
+      RadarFrame &frame = this->back_frame_();
+      frame.header = header;
+      frame.received_us = received_us;
+      if (this->read_frame_data_(header)) {
+        // Stamp the frame: radar time aligned to the local clock, then parse completion
+        if (header.frame_number < this->last_frame_number_) {
+          this->radar_clock_.reset();  // Radar restarted
+        }
+        this->last_frame_number_ = header.frame_number;
+        // received_us is stamped before the bulk read, so parse minus capture includes this frame's transfer
+        frame.capture_us = this->radar_clock_.update(header.time_cpu_cycles, received_us);
+        frame.parsed_us = this->micros64_();
+        this->parse_latency_.add(std::max<int64_t>(0, frame.parsed_us - frame.capture_us));
+
+        this->frame_count_++;
+        if (this->reconfig_start_time_ != 0) {
+          this->last_reconfig_ms_ = this->last_frame_time_ - this->reconfig_start_time_;
+          this->reconfig_start_time_ = 0;
+          ESP_LOGD(TAG, "Frame period %.0f ms live %u ms after sensorStart", this->frame_period_,
+                   this->last_reconfig_ms_);
+        }
+        this->front_frame_ ^= 1;  // Completed frame becomes visible to consumers
+        this->update_occupancy_analytics_(this->last_frame_time_ - previous_frame_time);
+        if (this->clutter_map_enabled_) {
+          this->clutter_map_.update(frame.points.x, frame.points.y, frame.points.size,
+                                    this->last_frame_time_ - previous_frame_time);
+        }
+        this->update_sensors_();
+#ifdef USE_IWR6843_TRAJECTORY
+        this->record_trajectory_(frame);
+#endif
+        this->frame_callback_.call(this->get_last_frame());
+        this->publish_capture_us_ = frame.capture_us;
+        if (this->publish_depth_ == 0) {
+          // Nothing queued for this frame; otherwise recorded once the queue drains
+          this->publish_latency_.add(std::max<int64_t>(0, this->micros64_() - frame.capture_us));
+        }
+        frame_processed = true;
+        IWR6843_HOT_LOGD("Frame %u processed successfully", this->frame_count_);
+        uint32_t frame_us = micros() - parse_start;
+        this->trace_(TRACE_FRAME_PROCESSED, this->frame_count_, frame_us);
+        this->avg_frame_us_ += (frame_us - this->avg_frame_us_) * 0.05f;
+        this->avg_frame_bytes_ += (header.total_packet_len - this->avg_frame_bytes_) * 0.05f;
+        
+        // Cleanup old tracks every 50 frames
+        if (this->frame_count_ % 50 == 0) {
+          this->cleanup_old_tracks_();
+        }
+      }
+    }
+  }
+
+  return frame_processed;
+}
+
+// Adaptive frame rate
+void IWR6843Component::update_frame_rate_(uint32_t now) {
+  if (this->frame_num_tracks_ > 0) {
+    this->last_activity_time_ = now;
+    if (this->idle_mode_) {
+      ESP_LOGI(TAG, "Target detected, returning to full frame rate");
+      this->set_frame_period_(ACTIVE_FRAME_PERIOD, now);
+    }
+  } else if (!this->idle_mode_ && now - this->last_activity_time_ > this->idle_timeout_) {
+    ESP_LOGI(TAG, "No targets for %u s, slowing frame rate to %.0f ms", this->idle_timeout_ / 1000,
+             this->idle_frame_period_);
+    this->set_frame_period_(this->idle_frame_period_, now);
+  }
+}
+
+void IWR6843Component::set_frame_period_(float period, uint32_t now) {
+  if (!this->config_queue_.empty()) {
+    return;  // Another push is in flight; retried on a later frame
+  }
+  this->close_mode_interval_(now);
+  this->idle_mode_ = period > ACTIVE_FRAME_PERIOD;
+
+  // Queued like recovery so loop() never blocks. frameCfg only needs a stop/start; trackingCfg is
+  // resent with it because the tracker's motion model takes the frame period as its time step
+  this->config_queue_ = {
+      {"sensorStop", 100},
+      {this->frame_cfg_command_(period), 0},
+      {this->tracking_cfg_command_(period), 0},
+      {"sensorStart", 0},
+  };
+  this->config_queue_pos_ = 0;
+  this->next_config_time_ = now;
+  this->pending_frame_period_ = period;
+}
+
+void IWR6843Component::close_mode_interval_(uint32_t now) {
+  // Fold the time (and skipped frames) since the last mode change into the totals
+  uint32_t elapsed = now - this->mode_start_time_;
+  if (this->idle_mode_) {
+    this->idle_mode_ms_ += elapsed;
+    uint32_t full_rate_frames = elapsed / ACTIVE_FRAME_PERIOD;
+    uint32_t received = this->frame_count_ - this->mode_start_frame_;
+    if (full_rate_frames > received) {
+      this->frames_saved_ += full_rate_frames - received;
+    }
+  } else {
+    this->active_mode_ms_ += elapsed;
+  }
+  this->mode_start_time_ = now;
+  this->mode_start_frame_ = this->frame_count_;
 }
 
 // SPI Frame Reading
@@ -297,42 +797,39 @@ bool IWR6843Component::find_magic_word_spi_() {
   static uint32_t attempt_count = 0;
   
   // Read bytes and search for magic word
-  uint8_t buffer[128];
-  size_t bytes_read = 0;
-  
+  uint8_t buffer[MAGIC_SEARCH_SIZE];
+
   // CS is automatically handled by SPIDevice::enable() and disable()
   this->enable();
-  
-  // Search for magic word
-  while (bytes_read < 128) {
-    this->spi_read_array_(&buffer[bytes_read], 1);  // Read 1 byte via SPI (explicit)
-    bytes_read++;
-    
-    // Check if we found the magic word
-    if (bytes_read >= MAGIC_WORD_SIZE) {
-      bool found = true;
-      for (size_t i = 0; i < MAGIC_WORD_SIZE; i++) {
-        if (buffer[bytes_read - MAGIC_WORD_SIZE + i] != MAGIC_WORD[i]) {
-          found = false;
-          break;
-        }
-      }
-      
-      if (found) {
-        // Found magic word, store remaining bytes in buffer
-        this->spi_buffer_.clear();
-        for (size_t i = bytes_read - MAGIC_WORD_SIZE; i < bytes_read; i++) {
-          this->spi_buffer_.push_back(buffer[i]);
-        }
-        ESP_LOGV(TAG, "Magic word found after %u bytes", bytes_read);
-        return true;
-      }
+
+  // Clock the whole search window in one transfer, then scan it
+  this->spi_read_array_(buffer, MAGIC_SEARCH_SIZE);
+
+  for (size_t start = 0; start + MAGIC_WORD_SIZE <= MAGIC_SEARCH_SIZE; start++) {
+    if (buffer[start] != MAGIC_WORD[0] || memcmp(&buffer[start], MAGIC_WORD, MAGIC_WORD_SIZE) != 0) {
+      continue;
     }
+
+    // Found magic word, keep it and every byte clocked after it (start of the header)
+    this->spi_buffer_.assign(&buffer[start], &buffer[MAGIC_SEARCH_SIZE]);
+    IWR6843_HOT_LOGV("Magic word found after %u bytes", start + MAGIC_WORD_SIZE);
+    this->trace_(TRACE_MAGIC_FOUND, start + MAGIC_WORD_SIZE);
+    return true;
   }
-  
+
   // Disable CS
   this->disable();
-  
+
+  // Non-idle bytes without a magic word mean the link is garbling data
+  bool idle = true;
+  for (size_t i = 0; i < MAGIC_SEARCH_SIZE && idle; i++) {
+    idle = (buffer[i] == 0x00 || buffer[i] == 0xFF);
+  }
+  if (!idle) {
+    this->spi_sync_losses_++;
+    this->spi_link_error_();
+  }
+
   // Debug logging every 10 seconds
   attempt_count++;
   uint32_t now = millis();
@@ -346,25 +843,18 @@ bool IWR6843Component::find_magic_word_spi_() {
     last_log_time = now;
     attempt_count = 0;
   }
-  
+
   return false;
 }
 
 bool IWR6843Component::read_frame_header_(FrameHeader &header) {
-  // Read rest of header (40 - 8 = 32 bytes)
-  size_t bytes_needed = FRAME_HEADER_SIZE - this->spi_buffer_.size();
-  
-  for (size_t i = 0; i < bytes_needed; i++) {
-    uint8_t byte;
-    this->spi_read_array_(&byte, 1);  // Read 1 byte via SPI (explicit)
-    this->spi_buffer_.push_back(byte);
-  }
-  
-  // Parse header
-  if (this->spi_buffer_.size() < FRAME_HEADER_SIZE) {
-    return false;
+  // Read rest of header (the magic search usually clocked part or all of it already)
+  size_t buffered = this->spi_buffer_.size();
+  if (buffered < FRAME_HEADER_SIZE) {
+    this->spi_buffer_.resize(FRAME_HEADER_SIZE);
+    this->spi_read_array_(&this->spi_buffer_[buffered], FRAME_HEADER_SIZE - buffered);
   }
-  
+
   // Extract header fields (little-endian)
   memcpy(&header.magic_word, &this->spi_buffer_[0], 8);
   memcpy(&header.version, &this->spi_buffer_[8], 4);
@@ -375,41 +865,110 @@ bool IWR6843Component::read_frame_header_(FrameHeader &header) {
   memcpy(&header.num_detected_obj, &this->spi_buffer_[28], 4);
   memcpy(&header.num_tlvs, &this->spi_buffer_[32], 4);
   memcpy(&header.subframe_number, &this->spi_buffer_[36], 4);
-  
+
   // Sanity check
   if (header.total_packet_len > MAX_FRAME_SIZE || header.total_packet_len < FRAME_HEADER_SIZE) {
     ESP_LOGW(TAG, "Invalid frame length: %d", header.total_packet_len);
+    this->trace_(TRACE_INVALID_LENGTH, header.total_packet_len);
+    this->disable();
+    this->spi_invalid_frames_++;
+    this->spi_link_error_();
     return false;
   }
-  
+
   return true;
 }
 
 bool IWR6843Component::read_frame_data_(const FrameHeader &header) {
-  // Read remaining frame data
-  size_t remaining_bytes = header.total_packet_len - FRAME_HEADER_SIZE;
-  
-  for (size_t i = 0; i < remaining_bytes; i++) {
-    uint8_t byte;
-    this->spi_read_array_(&byte, 1);  // Read 1 byte via SPI (explicit)
-    this->spi_buffer_.push_back(byte);
+  // Read remaining frame data in one transfer; bytes clocked past the packet end are dropped
+  size_t buffered = this->spi_buffer_.size();
+  if (buffered < header.total_packet_len) {
+    this->spi_buffer_.resize(header.total_packet_len);
+    this->spi_read_array_(&this->spi_buffer_[buffered], header.total_packet_len - buffered);
+  } else {
+    this->spi_buffer_.resize(header.total_packet_len);
   }
-  
+  size_t remaining_bytes = header.total_packet_len - FRAME_HEADER_SIZE;
+
   // Disable CS
   this->disable();
-  
+
   // Parse TLV data
   bool success = this->parse_tlv_data_(&this->spi_buffer_[FRAME_HEADER_SIZE], remaining_bytes);
-  
+
   if (success) {
     this->last_frame_time_ = millis();
+    this->spi_link_ok_();
+  } else {
+    this->spi_invalid_frames_++;
+    this->spi_link_error_();
   }
-  
+
   return success;
 }
 
+// SPI clock auto-tuning: step up after a run of clean frames, fall back and cap on repeated errors
+void IWR6843Component::spi_link_ok_() {
+  if (!this->spi_auto_tune_) {
+    return;
+  }
+
+  if (++this->spi_clean_frames_ < SPI_TUNE_STEP_FRAMES) {
+    return;
+  }
+  this->spi_clean_frames_ = 0;
+  this->spi_rate_errors_ = 0;
+
+  for (uint32_t rate : SPI_DATA_RATES) {
+    if (rate > this->spi_data_rate_) {
+      if (rate <= this->spi_max_data_rate_) {
+        ESP_LOGI(TAG, "SPI link clean, stepping clock up to %u Hz", rate);
+        this->apply_spi_data_rate_(rate);
+      }
+      return;
+    }
+  }
+}
+
+void IWR6843Component::spi_link_error_() {
+  this->spi_clean_frames_ = 0;
+  if (!this->spi_auto_tune_ || ++this->spi_rate_errors_ < SPI_TUNE_ERROR_LIMIT) {
+    return;
+  }
+  this->spi_rate_errors_ = 0;
+
+  uint32_t lower = 0;
+  for (uint32_t rate : SPI_DATA_RATES) {
+    if (rate < this->spi_data_rate_) {
+      lower = rate;
+    }
+  }
+  if (lower == 0) {
+    return;  // Already at the slowest rate
+  }
+
+  // Never try the failing rate again this boot
+  this->spi_max_data_rate_ = lower;
+  ESP_LOGW(TAG, "SPI link errors at %u Hz, falling back to %u Hz", this->spi_data_rate_, lower);
+  this->apply_spi_data_rate_(lower);
+}
+
+void IWR6843Component::apply_spi_data_rate_(uint32_t rate) {
+  // Called with CS released; re-register with the bus so the new clock takes effect
+  this->spi_teardown();
+  this->set_data_rate(rate);
+  this->spi_setup();
+  this->spi_data_rate_ = rate;
+}
+
 bool IWR6843Component::parse_tlv_data_(const uint8_t *data, size_t length) {
   size_t offset = 0;
+  TargetHeight heights[MAX_TARGET_HEIGHTS];
+  size_t num_heights = 0;
+  this->frame_num_tracks_ = 0;
+  RadarFrame &frame = this->back_frame_();
+  frame.num_tracks = 0;
+  frame.points.size = 0;
   
   while (offset + 8 <= length) {
     // Read TLV header
@@ -428,35 +987,149 @@ bool IWR6843Component::parse_tlv_data_(const uint8_t *data, size_t length) {
     if (tlv_type == TLVTYPE_TRACKED_TARGETS) {
       // Parse track data
       size_t num_tracks = tlv_length / 68;  // Each track is 68 bytes
+      TrackBatch batch;
+      batch.size = 0;
       
-      for (size_t i = 0; i < num_tracks && i < this->max_tracks_; i++) {
+      for (size_t i = 0; i < num_tracks && i < this->max_tracks_ && i < MAX_FRAME_TRACKS; i++) {
         size_t track_offset = offset + (i * 68);
+        uint8_t n = batch.size++;
         
         // Extract track data (68 bytes per track)
         uint32_t radar_id_raw;
-        float x, y, z, vel_x, vel_y, vel_z, confidence;
-        
         memcpy(&radar_id_raw, &data[track_offset], 4);
-        uint8_t radar_id = (uint8_t) radar_id_raw;
-        memcpy(&x, &data[track_offset + 4], 4);
-        memcpy(&y, &data[track_offset + 8], 4);
-        memcpy(&z, &data[track_offset + 12], 4);
-        memcpy(&vel_x, &data[track_offset + 16], 4);
-        memcpy(&vel_y, &data[track_offset + 20], 4);
-        memcpy(&vel_z, &data[track_offset + 24], 4);
-        memcpy(&confidence, &data[track_offset + 44], 4);  // Confidence at offset 44
-        
+        batch.radar_id[n] = (uint8_t) radar_id_raw;
+        memcpy(&batch.x[n], &data[track_offset + 4], 4);
+        memcpy(&batch.y[n], &data[track_offset + 8], 4);
+        memcpy(&batch.z[n], &data[track_offset + 12], 4);
+        memcpy(&batch.vel_x[n], &data[track_offset + 16], 4);
+        memcpy(&batch.vel_y[n], &data[track_offset + 20], 4);
+        memcpy(&batch.vel_z[n], &data[track_offset + 24], 4);
+        memcpy(&batch.confidence[n], &data[track_offset + 44], 4);  // Confidence at offset 44
+      }
+
+      this->mounting_.tracks_to_room(batch.x, batch.y, batch.z, batch.vel_x, batch.vel_y, batch.vel_z, batch.size);
+
+      for (uint8_t i = 0; i < batch.size; i++) {
+        // The radar's boundary is the tracker-frame hull; drop what falls outside the room box
+        if (!this->is_within_boundary_(batch.x[i], batch.y[i], batch.z[i], this->tracking_boundary_)) {
+          continue;
+        }
+
+        // Ghosts in learned clutter cells never get a display ID
+        if (this->clutter_map_enabled_ &&
+            this->clutter_map_.observe_track(batch.radar_id[i], batch.x[i], batch.y[i], this->last_frame_time_)) {
+          continue;
+        }
+
         // Process track
-        this->process_track_data_(radar_id, x, y, z, vel_x, vel_y, vel_z, confidence);
+        this->frame_num_tracks_++;
+        this->process_track_data_(batch.radar_id[i], batch.x[i], batch.y[i], batch.z[i], batch.vel_x[i],
+                                  batch.vel_y[i], batch.vel_z[i], batch.confidence[i]);
+      }
+    } else if (tlv_type == TLVTYPE_TARGET_HEIGHT) {
+      // Per-target height extent, joined to tracks once all TLVs are parsed
+      size_t count = tlv_length / TARGET_HEIGHT_SIZE;
+
+      for (size_t i = 0; i < count && num_heights < MAX_TARGET_HEIGHTS; i++) {
+        size_t height_offset = offset + (i * TARGET_HEIGHT_SIZE);
+        uint32_t radar_id_raw;
+        TargetHeight &height = heights[num_heights++];
+
+        memcpy(&radar_id_raw, &data[height_offset], 4);
+        height.radar_id = (uint8_t) radar_id_raw;
+        memcpy(&height.max_z, &data[height_offset + 4], 4);
+        memcpy(&height.min_z, &data[height_offset + 8], 4);
+      }
+    } else if (frame.points.size == 0) {
+      // Point cloud: the first point TLV in the frame wins
+      if (tlv_type == TLVTYPE_DETECTED_POINTS) {
+        this->parse_cartesian_points_(&data[offset], tlv_length, frame.points);
+      } else if (tlv_type == TLVTYPE_POINT_CLOUD) {
+        this->parse_spherical_points_(&data[offset], tlv_length, frame.points);
+      } else if (tlv_type == TLVTYPE_COMPRESSED_SPHERICAL_POINTS) {
+        this->parse_compressed_points_(&data[offset], tlv_length, frame.points);
       }
     }
     
     offset += tlv_length;
   }
-  
+
+  // Points arrive in the sensor frame; one pass moves the whole cloud to the room frame
+  this->mounting_.points_to_room(frame.points.x, frame.points.y, frame.points.z, frame.points.size);
+
+  this->finalize_frame_tracks_(heights, num_heights);
+
   return true;
 }
 
+void IWR6843Component::parse_cartesian_points_(const uint8_t *data, size_t length, PointCloud &points) {
+  size_t count = std::min(length / POINT_SIZE, MAX_FRAME_POINTS);
+  for (size_t i = 0; i < count; i++) {
+    const uint8_t *p = &data[i * POINT_SIZE];
+    memcpy(&points.x[i], p, 4);
+    memcpy(&points.y[i], p + 4, 4);
+    memcpy(&points.z[i], p + 8, 4);
+    memcpy(&points.doppler[i], p + 12, 4);
+    points.snr[i] = 0.0f;
+  }
+  points.size = count;
+}
+
+void IWR6843Component::parse_spherical_points_(const uint8_t *data, size_t length, PointCloud &points) {
+  size_t count = std::min(length / POINT_SIZE, MAX_FRAME_POINTS);
+  for (size_t i = 0; i < count; i++) {
+    const uint8_t *p = &data[i * POINT_SIZE];
+    float range, azimuth, elevation;
+    memcpy(&range, p, 4);
+    memcpy(&azimuth, p + 4, 4);
+    memcpy(&elevation, p + 8, 4);
+    memcpy(&points.doppler[i], p + 12, 4);
+
+    float horizontal = range * cosf(elevation);
+    points.x[i] = horizontal * sinf(azimuth);
+    points.y[i] = horizontal * cosf(azimuth);
+    points.z[i] = range * sinf(elevation);
+    points.snr[i] = 0.0f;
+  }
+  points.size = count;
+}
+
+void IWR6843Component::parse_compressed_points_(const uint8_t *data, size_t length, PointCloud &points) {
+  if (length < COMPRESSED_UNIT_SIZE) {
+    return;
+  }
+
+  float elevation_unit, azimuth_unit, doppler_unit, range_unit, snr_unit;
+  memcpy(&elevation_unit, data, 4);
+  memcpy(&azimuth_unit, data + 4, 4);
+  memcpy(&doppler_unit, data + 8, 4);
+  memcpy(&range_unit, data + 12, 4);
+  memcpy(&snr_unit, data + 16, 4);
+
+  size_t count = std::min((length - COMPRESSED_UNIT_SIZE) / COMPRESSED_POINT_SIZE, MAX_FRAME_POINTS);
+  for (size_t i = 0; i < count; i++) {
+    const uint8_t *p = &data[COMPRESSED_UNIT_SIZE + i * COMPRESSED_POINT_SIZE];
+    int8_t elevation_raw = (int8_t) p[0];
+    int8_t azimuth_raw = (int8_t) p[1];
+    int16_t doppler_raw;
+    uint16_t range_raw, snr_raw;
+    memcpy(&doppler_raw, p + 2, 2);
+    memcpy(&range_raw, p + 4, 2);
+    memcpy(&snr_raw, p + 6, 2);
+
+    float range = range_raw * range_unit;
+    float elevation = elevation_raw * elevation_unit;
+    float azimuth = azimuth_raw * azimuth_unit;
+    float horizontal = range * cosf(elevation);
+    points.x[i] = horizontal * sinf(azimuth);
+    points.y[i] = horizontal * cosf(azimuth);
+    points.z[i] = range * sinf(elevation);
+    points.doppler[i] = doppler_raw * doppler_unit;
+    points.snr[i] = snr_raw * snr_unit;
+  }
+  points.size = count;
+}
+
 // Data processing
 void IWR6843Component::process_track_data_(uint8_t radar_id, float x, float y, float z, float vel_x, float vel_y,
                                             float vel_z, float confidence) {
@@ -482,16 +1155,47 @@ void IWR6843Component::process_track_data_(uint8_t radar_id, float x, float y, f
   track.confidence = confidence;
   track.is_present = is_present;
   track.last_seen = this->frame_count_;
-  
-  // Fall detection
-  track.is_fallen = this->detect_fall_(track);
-  
-  ESP_LOGD(TAG, "Track ID %d (Radar %d): X=%.2f Y=%.2f Z=%.2f Vel=%.2f Present=%d Fallen=%d",
-           display_id, radar_id, x, y, z, vel_z, is_present, track.is_fallen);
+  track.has_height = false;
+}
+
+void IWR6843Component::finalize_frame_tracks_(const TargetHeight *heights, size_t num_heights) {
+  for (auto &pair : this->tracks_) {
+    TrackData &track = pair.second;
+    if (track.last_seen != this->frame_count_) {
+      continue;  // Not updated this frame
+    }
+
+    // Join height extent by radar target ID; heights are tracker-frame z at the target
+    for (size_t i = 0; i < num_heights; i++) {
+      if (heights[i].radar_id == track.radar_id) {
+        track.has_height = true;
+        track.max_height = this->mounting_.height_to_room(track.x, track.y, track.z, heights[i].max_z);
+        track.min_height = this->mounting_.height_to_room(track.x, track.y, track.z, heights[i].min_z);
+        break;
+      }
+    }
+
+    // Fall detection
+    track.is_fallen = this->detect_fall_(track);
+
+    RadarFrame &frame = this->back_frame_();
+    if (frame.num_tracks < MAX_FRAME_TRACKS) {
+      frame.tracks[frame.num_tracks++] = track;
+    }
+
+    IWR6843_HOT_LOGD("Track ID %d (Radar %d): X=%.2f Y=%.2f Z=%.2f Vel=%.2f H=%.2f Posture=%d Present=%d Fallen=%d",
+                     pair.first, track.radar_id, track.x, track.y, track.z, track.vel_z, track.max_height,
+                     track.posture, track.is_present, track.is_fallen);
+    this->trace_(TRACE_TRACK,
+                 (pair.first << 16) | (track.radar_id << 8) | (track.is_present << 1) | track.is_fallen,
+                 ((uint32_t) (uint16_t) (int16_t) (track.x * 100.0f) << 16) | (uint16_t) (int16_t) (track.y * 100.0f),
+                 ((uint32_t) (uint16_t) (int16_t) (track.z * 100.0f) << 16) |
+                     (uint16_t) (int16_t) (track.vel_z * 1000.0f));
+  }
 }
 
 void IWR6843Component::update_sensors_() {
-  // Update all sensor values
+  // Queue all sensor values (published by drain_publish_queue_)
   for (uint8_t id = 1; id <= 5; id++) {
     auto it = this->tracks_.find(id);
     
@@ -500,24 +1204,27 @@ void IWR6843Component::update_sensors_() {
       
       // Update binary sensors
       if (this->presence_sensors_.count(id)) {
-        this->presence_sensors_[id]->publish_state(true);
+        this->queue_publish_(PUBLISH_PRESENCE, id, 1.0f);
       }
       if (this->fall_sensors_.count(id)) {
-        this->fall_sensors_[id]->publish_state(track.is_fallen);
+        this->queue_publish_(PUBLISH_FALL, id, track.is_fallen);
       }
       
       // Update numeric sensors (convert to cm and mm/s)
       if (this->x_coordinate_sensors_.count(id)) {
-        this->x_coordinate_sensors_[id]->publish_state(track.x * 100.0f);  // m to cm
+        this->queue_publish_(PUBLISH_X, id, track.x * 100.0f);  // m to cm
       }
       if (this->y_coordinate_sensors_.count(id)) {
-        this->y_coordinate_sensors_[id]->publish_state(track.y * 100.0f);  // m to cm
+        this->queue_publish_(PUBLISH_Y, id, track.y * 100.0f);  // m to cm
       }
       if (this->z_coordinate_sensors_.count(id)) {
-        this->z_coordinate_sensors_[id]->publish_state(track.z * 100.0f);  // m to cm
+        this->queue_publish_(PUBLISH_Z, id, track.z * 100.0f);  // m to cm
       }
       if (this->velocity_sensors_.count(id)) {
-        this->velocity_sensors_[id]->publish_state(track.vel_z * 1000.0f);  // m/s to mm/s
+        this->queue_publish_(PUBLISH_VELOCITY, id, track.vel_z * 1000.0f);  // m/s to mm/s
+      }
+      if (this->height_sensors_.count(id) && track.has_height) {
+        this->queue_publish_(PUBLISH_HEIGHT, id, track.max_height * 100.0f);  // m to cm
       }
     } else {
       // Track not present - reset to 0
@@ -529,30 +1236,121 @@ void IWR6843Component::update_sensors_() {
 void IWR6843Component::reset_track_data_(uint8_t id) {
   // Set presence to clear
   if (this->presence_sensors_.count(id)) {
-    this->presence_sensors_[id]->publish_state(false);
+    this->queue_publish_(PUBLISH_PRESENCE, id, 0.0f);
   }
   if (this->fall_sensors_.count(id)) {
-    this->fall_sensors_[id]->publish_state(false);
+    this->queue_publish_(PUBLISH_FALL, id, 0.0f);
   }
   
   // Set all numeric values to 0
   if (this->x_coordinate_sensors_.count(id)) {
-    this->x_coordinate_sensors_[id]->publish_state(0.0f);
+    this->queue_publish_(PUBLISH_X, id, 0.0f);
   }
   if (this->y_coordinate_sensors_.count(id)) {
-    this->y_coordinate_sensors_[id]->publish_state(0.0f);
+    this->queue_publish_(PUBLISH_Y, id, 0.0f);
   }
   if (this->z_coordinate_sensors_.count(id)) {
-    this->z_coordinate_sensors_[id]->publish_state(0.0f);
+    this->queue_publish_(PUBLISH_Z, id, 0.0f);
   }
   if (this->velocity_sensors_.count(id)) {
-    this->velocity_sensors_[id]->publish_state(0.0f);
+    this->queue_publish_(PUBLISH_VELOCITY, id, 0.0f);
+  }
+  if (this->height_sensors_.count(id)) {
+    this->queue_publish_(PUBLISH_HEIGHT, id, 0.0f);
   }
   
   // Reset track data in memory
   if (this->tracks_.count(id)) {
     this->tracks_[id].is_present = false;
     this->tracks_[id].is_fallen = false;
+    this->tracks_[id].posture = POSTURE_UNKNOWN;
+    this->tracks_[id].upright_time = 0;
+    this->tracks_[id].peak_height = 0.0f;
+    this->tracks_[id].lying_frames = 0;
+  }
+}
+
+#ifdef USE_IWR6843_TRAJECTORY
+void IWR6843Component::record_trajectory_(const RadarFrame &frame) {
+  uint8_t seen = 0;
+  for (uint8_t i = 0; i < frame.num_tracks; i++) {
+    const TrackData &track = frame.tracks[i];
+    if (track.is_present) {
+      this->trajectory_.add(track.id - 1, this->last_frame_time_, track.x, track.y, track.z);
+      seen |= 1 << track.id;
+    }
+  }
+  for (uint8_t id = 1; id <= MAX_FRAME_TRACKS; id++) {
+    if ((seen & (1 << id)) == 0) {
+      this->trajectory_.end(id - 1);
+    }
+  }
+}
+#endif
+
+// Publish scheduler
+void IWR6843Component::queue_publish_(PublishSlot slot, uint8_t id, float value) {
+  uint8_t bit = 1 << id;
+  this->publish_values_[slot][id] = value;  // Replaces a pending value
+  if ((this->publish_pending_[slot] & bit) == 0) {
+    this->publish_pending_[slot] |= bit;
+    this->publish_depth_++;
+    this->publish_peak_depth_ = std::max(this->publish_peak_depth_, this->publish_depth_);
+  }
+}
+
+void IWR6843Component::publish_slot_(PublishSlot slot, uint8_t id, float value) {
+  switch (slot) {
+    case PUBLISH_FALL:
+      this->fall_sensors_[id]->publish_state(value != 0.0f);
+      break;
+    case PUBLISH_PRESENCE:
+      this->presence_sensors_[id]->publish_state(value != 0.0f);
+      break;
+    case PUBLISH_X:
+      this->x_coordinate_sensors_[id]->publish_state(value);
+      break;
+    case PUBLISH_Y:
+      this->y_coordinate_sensors_[id]->publish_state(value);
+      break;
+    case PUBLISH_Z:
+      this->z_coordinate_sensors_[id]->publish_state(value);
+      break;
+    case PUBLISH_VELOCITY:
+      this->velocity_sensors_[id]->publish_state(value);
+      break;
+    case PUBLISH_HEIGHT:
+      this->height_sensors_[id]->publish_state(value);
+      break;
+    default:
+      break;
+  }
+}
+
+void IWR6843Component::drain_publish_queue_() {
+  if (this->publish_depth_ == 0) {
+    return;
+  }
+
+  // Fall and presence slots (at most 10 updates) drain in full on every pass, outside the budget, so a
+  // fall or presence change goes out on the pass after its frame; the remaining slots stop at the budget
+  uint32_t start = micros();
+  for (uint8_t slot = 0; slot < PUBLISH_SLOT_COUNT; slot++) {
+    while (this->publish_pending_[slot] != 0) {
+      if (slot > PUBLISH_PRESENCE && micros() - start >= this->publish_budget_) {
+        this->publish_overruns_++;
+        return;
+      }
+      uint8_t id = __builtin_ctz(this->publish_pending_[slot]);
+      this->publish_pending_[slot] &= ~(1 << id);
+      this->publish_depth_--;
+      this->publish_slot_((PublishSlot) slot, id, this->publish_values_[slot][id]);
+    }
+  }
+
+  if (this->publish_capture_us_ != 0) {
+    this->publish_latency_.add(std::max<int64_t>(0, this->micros64_() - this->publish_capture_us_));
+    this->publish_capture_us_ = 0;
   }
 }
 
@@ -565,9 +1363,188 @@ void IWR6843Component::cleanup_old_tracks_() {
   }
 }
 
-// Fall detection (simplified version)
-bool IWR6843Component::detect_fall_(const TrackData &track) {
-  // Simple fall detection based on Z coordinate drop and velocity
+// Occupancy analytics
+void IWR6843Component::update_occupancy_analytics_(uint32_t frame_dt) {
+  // Credit each present track with the time since the previous frame; O(tracks * zones)
+  if (frame_dt > MAX_HEATMAP_FRAME_GAP) {
+    frame_dt = MAX_HEATMAP_FRAME_GAP;
+  }
+
+  const BoundaryBox &box = this->tracking_boundary_;
+  float width = box.x_max - box.x_min;
+  float depth = box.y_max - box.y_min;
+  if (width <= 0.0f || depth <= 0.0f) {
+    return;
+  }
+  float scale_x = HEATMAP_GRID_SIZE / width;
+  float scale_y = HEATMAP_GRID_SIZE / depth;
+
+  for (const auto &pair : this->tracks_) {
+    const TrackData &track = pair.second;
+    if (!track.is_present || !this->seen_in_last_frame_(track)) {
+      continue;
+    }
+
+    int cx = (int) ((track.x - box.x_min) * scale_x);
+    int cy = (int) ((track.y - box.y_min) * scale_y);
+    if (cx >= 0 && cx < HEATMAP_GRID_SIZE && cy >= 0 && cy < HEATMAP_GRID_SIZE) {
+      uint32_t &cell = this->heatmap_[cy * HEATMAP_GRID_SIZE + cx];
+      cell = (cell > UINT32_MAX - frame_dt) ? UINT32_MAX : cell + frame_dt;  // Saturate
+    }
+
+    for (uint8_t i = 0; i < this->num_zones_; i++) {
+      if (this->is_within_boundary_(track.x, track.y, track.z, this->zones_[i].box)) {
+        uint32_t &dwell = this->zones_[i].dwell_ms;
+        dwell = (dwell > UINT32_MAX - frame_dt) ? UINT32_MAX : dwell + frame_dt;  // Saturate
+      }
+    }
+  }
+}
+
+void IWR6843Component::publish_diagnostics_() {
+  // End-to-end latency (ms)
+  if (this->radar_clock_.is_synced()) {
+    this->publish_diagnostic_(LATENCY_PARSE_P50, this->parse_latency_.percentile(50) / 1000.0f);
+    this->publish_diagnostic_(LATENCY_PARSE_P95, this->parse_latency_.percentile(95) / 1000.0f);
+    this->publish_diagnostic_(LATENCY_PUBLISH_P50, this->publish_latency_.percentile(50) / 1000.0f);
+    this->publish_diagnostic_(LATENCY_PUBLISH_P95, this->publish_latency_.percentile(95) / 1000.0f);
+    this->publish_diagnostic_(CLOCK_DRIFT, this->radar_clock_.drift_ppm());
+  }
+
+  // Publish scheduler (link state and MTTR go out on transitions, from set_link_state_)
+  this->publish_diagnostic_(PUBLISH_QUEUE_DEPTH, this->publish_peak_depth_);
+  this->publish_diagnostic_(PUBLISH_OVERRUNS, this->publish_overruns_);
+  this->publish_peak_depth_ = this->publish_depth_;
+
+  if (this->clutter_map_enabled_) {
+    uint32_t suppressed = this->clutter_map_.suppressed_tracks();
+    this->publish_diagnostic_(CLUTTER_CELLS, this->clutter_map_.clutter_cells());
+    this->publish_diagnostic_(SUPPRESSED_TRACKS_PER_HOUR,
+                              (suppressed - this->last_suppressed_tracks_) * 3600000.0f / this->diagnostics_interval_);
+    this->last_suppressed_tracks_ = suppressed;
+  }
+
+  // Adaptive frame rate: time per mode (including the open interval) and estimated savings
+  if (this->adaptive_frame_rate_) {
+    this->close_mode_interval_(millis());
+    this->publish_diagnostic_(ACTIVE_MODE_TIME, this->active_mode_ms_ / 1000.0f);
+    this->publish_diagnostic_(IDLE_MODE_TIME, this->idle_mode_ms_ / 1000.0f);
+    this->publish_diagnostic_(RECONFIG_TIME, this->last_reconfig_ms_);
+    this->publish_diagnostic_(FRAMES_SAVED, this->frames_saved_);
+    this->publish_diagnostic_(CPU_TIME_SAVED, this->frames_saved_ * this->avg_frame_us_ / 1000000.0f);
+    this->publish_diagnostic_(SPI_BYTES_SAVED, this->frames_saved_ * this->avg_frame_bytes_ / 1024.0f);
+  }
+
+  // Zone dwell times (seconds)
+  for (uint8_t i = 0; i < this->num_zones_; i++) {
+    auto it = this->zone_dwell_sensors_.find(this->zones_[i].name);
+    if (it != this->zone_dwell_sensors_.end()) {
+      it->second->publish_state(this->zones_[i].dwell_ms / 1000.0f);
+    }
+  }
+
+  // Heatmap summary: hottest cell centre and visited share
+  size_t peak_index = 0;
+  size_t visited = 0;
+  for (size_t i = 0; i < this->heatmap_.size(); i++) {
+    if (this->heatmap_[i] > this->heatmap_[peak_index]) {
+      peak_index = i;
+    }
+    if (this->heatmap_[i] != 0) {
+      visited++;
+    }
+  }
+
+  const BoundaryBox &box = this->tracking_boundary_;
+  float cell_w = (box.x_max - box.x_min) / HEATMAP_GRID_SIZE;
+  float cell_d = (box.y_max - box.y_min) / HEATMAP_GRID_SIZE;
+  if (visited > 0) {
+    float peak_x = box.x_min + ((peak_index % HEATMAP_GRID_SIZE) + 0.5f) * cell_w;
+    float peak_y = box.y_min + ((peak_index / HEATMAP_GRID_SIZE) + 0.5f) * cell_d;
+    this->publish_diagnostic_(HEATMAP_PEAK_X, peak_x * 100.0f);  // m to cm
+    this->publish_diagnostic_(HEATMAP_PEAK_Y, peak_y * 100.0f);  // m to cm
+  }
+  this->publish_diagnostic_(HEATMAP_COVERAGE, visited * 100.0f / this->heatmap_.size());
+
+  // SPI link quality
+  this->publish_diagnostic_(SPI_DATA_RATE, this->spi_data_rate_ / 1000000.0f);
+  this->publish_diagnostic_(SPI_SYNC_LOSSES, this->spi_sync_losses_);
+  this->publish_diagnostic_(SPI_INVALID_FRAMES, this->spi_invalid_frames_);
+}
+
+void IWR6843Component::publish_diagnostic_(DiagnosticType type, float value) {
+  auto it = this->diagnostic_sensors_.find(type);
+  if (it != this->diagnostic_sensors_.end()) {
+    it->second->publish_state(value);
+  }
+}
+
+// Posture from target height extent
+Posture IWR6843Component::classify_posture_(const TrackData &track) {
+  if (!track.has_height) {
+    return POSTURE_UNKNOWN;
+  }
+  if (track.max_height >= POSTURE_STANDING_HEIGHT) {
+    return POSTURE_STANDING;
+  }
+  if (track.max_height < POSTURE_LYING_HEIGHT && track.max_height - track.min_height < POSTURE_LYING_EXTENT) {
+    return POSTURE_LYING;
+  }
+  return POSTURE_SITTING;
+}
+
+// Fall detection
+bool IWR6843Component::detect_fall_(TrackData &track) {
+  uint32_t now = millis();
+  Posture posture = this->classify_posture_(track);
+
+  if (posture != POSTURE_UNKNOWN) {
+    Posture previous = track.posture;
+    track.posture = posture;
+    this->fall_frame_counters_[track.id] = 0;
+
+    if (posture != POSTURE_LYING) {
+      // Upright again clears any fall; keep the recent peak as the drop reference
+      if (track.max_height >= FALL_UPRIGHT_HEIGHT) {
+        track.upright_time = now;
+      }
+      if (track.max_height >= track.peak_height || now - track.peak_time > FALL_FAST_WINDOW) {
+        track.peak_height = track.max_height;
+        track.peak_time = now;
+      }
+      track.lying_frames = 0;
+      return false;
+    }
+
+    if (track.lying_frames < UINT8_MAX) {
+      track.lying_frames++;
+    }
+    if (track.is_fallen) {
+      return true;  // Latched while still lying
+    }
+
+    // Fast path: first lying frame after a recent upright peak, at a fall-like drop rate
+    uint32_t since_peak = now - track.peak_time;
+    if (previous != POSTURE_LYING && track.peak_height >= FALL_UPRIGHT_HEIGHT && since_peak > 0 &&
+        since_peak <= FALL_FAST_WINDOW) {
+      float drop_rate = (track.peak_height - track.max_height) * 1000.0f / since_peak;
+      if (drop_rate >= FALL_DROP_RATE) {
+        return true;
+      }
+    }
+
+    // Slow path: lying persistently shortly after being upright (slow or assisted falls)
+    return track.upright_time != 0 && now - track.upright_time <= FALL_SLOW_WINDOW &&
+           track.lying_frames >= FALL_SLOW_FRAMES;
+  }
+
+  // No height for a track that has had one: hold the last posture and fall state. A still person on the
+  // floor often returns too few points for a height record, and the centroid rule below would clear the fall
+  if (track.posture != POSTURE_UNKNOWN) {
+    return track.is_fallen;
+  }
+
+  // Never had a height: fall back to centroid Z drop and velocity
   const float FALL_Z_THRESHOLD = 0.5f;  // meters
   const float FALL_VEL_THRESHOLD = -1.0f;  // m/s (downward)
   
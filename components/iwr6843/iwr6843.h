@@ -2,10 +2,18 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/preferences.h"
 #include "esphome/components/spi/spi.h"
 #include "esphome/components/uart/uart.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
+#include "clutter_map.h"
+#include "mounting.h"
+#include "radar_clock.h"
+#include "trajectory_store.h"
+#include <algorithm>
+#include <array>
 #include <vector>
 #include <map>
 
@@ -18,7 +26,24 @@ static const size_t MAGIC_WORD_SIZE = 8;
 static const size_t FRAME_HEADER_SIZE = 40;
 static const size_t MAX_FRAME_SIZE = 10000;
 static const uint32_t UART_BAUD_RATE = 115200;
-static const uint32_t SPI_SPEED = 2000000;  // 2 MHz
+static const uint32_t SPI_SPEED = 2000000;  // 2 MHz (default)
+static const uint32_t MAX_SPI_DATA_RATE = 40000000;  // IWR6843 SPI slave limit
+static const size_t MAGIC_SEARCH_SIZE = 128;         // Bytes clocked per sync attempt
+
+// SPI clock auto-tuning
+static const uint32_t SPI_DATA_RATES[] = {1000000, 2000000, 4000000, 5000000, 8000000, 10000000, 20000000, 40000000};
+static const uint16_t SPI_TUNE_STEP_FRAMES = 200;  // Clean frames before stepping the clock up
+static const uint8_t SPI_TUNE_ERROR_LIMIT = 3;     // Errors at a rate before falling back
+
+// On-device occupancy analytics (fixed size, allocated with the component)
+static const uint8_t HEATMAP_GRID_SIZE = 16;        // Cells per axis over the tracking boundary
+static const uint8_t MAX_ZONES = 4;                 // Dwell-time zones
+static const uint32_t MAX_HEATMAP_FRAME_GAP = 1000;  // ms, clamps dwell credited per frame
+
+// Binary trace ring (enabled with `trace: true`)
+static const size_t TRACE_BUFFER_SIZE = 128;     // Records, must be a power of two
+static const size_t TRACE_DRAIN_PER_LOOP = 4;    // Records logged per loop() pass
+static_assert((TRACE_BUFFER_SIZE & (TRACE_BUFFER_SIZE - 1)) == 0, "TRACE_BUFFER_SIZE must be a power of two");
 
 // TLV Types (from TI SDK)
 enum TLVType {
@@ -31,12 +56,136 @@ enum TLVType {
   TLVTYPE_COMPRESSED_SPHERICAL_POINTS = 9
 };
 
+// Adaptive frame rate
+static const float ACTIVE_FRAME_PERIOD = 120.0f;  // ms, full-rate frameCfg periodicity
+static const float MAX_FRAME_PERIOD = 1000.0f;    // ms, slowest idle periodicity
+
+// Decoded frame storage (double-buffered, see RadarFrame)
+static const size_t MAX_FRAME_POINTS = 256;  // Points kept per frame, extra points are dropped
+static const size_t MAX_FRAME_TRACKS = 5;    // Matches display IDs 1-5
+static const size_t POINT_SIZE = 16;         // TLV 1 (x, y, z, doppler) and TLV 6 (range, azimuth, elevation, doppler)
+static const size_t COMPRESSED_UNIT_SIZE = 20;  // TLV 9 header: elevation, azimuth, doppler, range, snr units
+static const size_t COMPRESSED_POINT_SIZE = 8;  // TLV 9 point: int8 elev, int8 azim, int16 doppler, uint16 range, snr
+
+// Link supervisor
+static const uint32_t LINK_LOST_TIMEOUT = 2000;      // ms degraded before tracks are cleared
+static const uint32_t LINK_RECOVERY_DELAY = 3000;    // ms lost before the first reset (doubles per attempt)
+static const uint32_t LINK_RECOVERY_TIMEOUT = 5000;  // ms after reconfiguration to see a frame
+static const uint8_t LINK_DEGRADED_FRAMES = 3;       // Missed frame periods before degraded
+static const uint32_t POLL_BACKOFF_MIN = 10;         // ms between sync attempts once degraded
+static const uint32_t POLL_BACKOFF_MAX = 1000;
+static const uint32_t CONFIG_COMMAND_SPACING = 50;   // ms after each CLI command
+
+// Publish scheduler
+static const uint32_t DEFAULT_PUBLISH_BUDGET = 2000;  // us of publish_state() work per loop() pass
+
+// Clutter map persistence
+static const uint32_t CLUTTER_SAVE_INTERVAL = 3600000;  // ms, limits flash wear
+
+// Trajectory history (enabled with `trajectory:`)
+static const size_t DEFAULT_TRAJECTORY_BUFFER_SIZE = 65536;  // Bytes, shared by IDs 1-5
+
+// End-to-end latency tracking
+static const size_t LATENCY_SAMPLES = 128;  // Most recent frames used for percentiles
+
+// Target height TLV (7): uint32 target ID, float max Z, float min Z
+static const size_t TARGET_HEIGHT_SIZE = 12;
+static const size_t MAX_TARGET_HEIGHTS = 20;  // Tracker limit per frame
+
+// Height-based posture and fall detection (heights in m above floor)
+static const float POSTURE_STANDING_HEIGHT = 1.2f;  // Max height at or above: standing
+static const float POSTURE_LYING_HEIGHT = 0.6f;     // Max height below: lying
+static const float POSTURE_LYING_EXTENT = 0.6f;     // Max-min extent below: lying
+static const float FALL_UPRIGHT_HEIGHT = 1.0f;      // Max height a fall must start from
+static const float FALL_DROP_RATE = 1.0f;           // m/s drop of max height for single-frame alert
+static const uint32_t FALL_FAST_WINDOW = 1000;      // ms, upright-to-lying window for single-frame alert
+static const uint32_t FALL_SLOW_WINDOW = 3000;      // ms, upright-to-lying window for slow falls
+static const uint8_t FALL_SLOW_FRAMES = 5;          // Lying frames to confirm a slow fall
+
 // Coordinate Type for Sensor Platform
 enum CoordinateType {
   X_COORDINATE = 0,
   Y_COORDINATE = 1,
   Z_COORDINATE = 2,
-  VELOCITY = 3
+  VELOCITY = 3,
+  HEIGHT = 4
+};
+
+// Posture classified from target height extent
+enum Posture : uint8_t {
+  POSTURE_UNKNOWN = 0,
+  POSTURE_STANDING = 1,
+  POSTURE_SITTING = 2,
+  POSTURE_LYING = 3
+};
+
+// Diagnostic sensor types (component-level, not per person)
+enum DiagnosticType {
+  HEATMAP_PEAK_X = 0,    // X of the most occupied heatmap cell (cm)
+  HEATMAP_PEAK_Y = 1,    // Y of the most occupied heatmap cell (cm)
+  HEATMAP_COVERAGE = 2,  // Share of heatmap cells ever occupied (%)
+  SPI_DATA_RATE = 3,     // Current SPI clock (MHz)
+  SPI_SYNC_LOSSES = 4,   // Sync attempts that clocked non-idle data without a magic word
+  SPI_INVALID_FRAMES = 5,  // Frames rejected for bad packet or TLV length
+  ACTIVE_MODE_TIME = 6,    // Time at full frame rate (s)
+  IDLE_MODE_TIME = 7,      // Time at idle frame rate (s)
+  RECONFIG_TIME = 8,       // Duration of the last frame-rate switch (ms)
+  FRAMES_SAVED = 9,        // Frames not produced thanks to idle mode
+  CPU_TIME_SAVED = 10,     // Estimated frame processing time saved (s)
+  SPI_BYTES_SAVED = 11,    // Estimated SPI traffic saved (KB)
+  LATENCY_PARSE_P50 = 12,    // Radar frame time to parsed (ms)
+  LATENCY_PARSE_P95 = 13,
+  LATENCY_PUBLISH_P50 = 14,  // Radar frame time to entities published (ms)
+  LATENCY_PUBLISH_P95 = 15,
+  CLOCK_DRIFT = 16,          // Radar vs. ESP32 clock drift (ppm)
+  LINK_STATE = 17,             // LinkState, published on every transition
+  MEAN_TIME_TO_RECOVERY = 18,  // Mean outage duration for outages that reached lost (s)
+  PUBLISH_QUEUE_DEPTH = 19,    // Peak pending entity updates since the last report
+  PUBLISH_OVERRUNS = 20,       // Loop passes that ran out of publish budget with updates pending
+  CLUTTER_CELLS = 21,          // Clutter map cells at or above the threshold
+  SUPPRESSED_TRACKS_PER_HOUR = 22,  // Ghost tracks dropped since the last report, per hour
+};
+
+// Per-person entity slots in the publish scheduler, drained in this order (safety-critical first)
+enum PublishSlot : uint8_t {
+  PUBLISH_FALL = 0,
+  PUBLISH_PRESENCE,
+  PUBLISH_X,
+  PUBLISH_Y,
+  PUBLISH_Z,
+  PUBLISH_VELOCITY,
+  PUBLISH_HEIGHT,
+  PUBLISH_SLOT_COUNT
+};
+
+// Radar link supervisor states
+enum LinkState : uint8_t {
+  LINK_STREAMING = 0,   // Frames arriving
+  LINK_DEGRADED = 1,    // A few frame periods missed, polling backs off
+  LINK_LOST = 2,        // Tracks cleared, waiting to reset
+  LINK_RECOVERING = 3,  // NRST pulsed and configuration being pushed
+};
+
+// Radar CLI command with extra settle time after the standard spacing
+struct ConfigCommand {
+  std::string command;
+  uint16_t extra_delay;  // ms
+};
+
+// Trace event IDs (binary trace ring)
+enum TraceEvent : uint8_t {
+  TRACE_MAGIC_FOUND = 1,      // args: bytes scanned
+  TRACE_FRAME_HEADER = 2,     // args: frame number, packet length, TLV count
+  TRACE_FRAME_PROCESSED = 3,  // args: frame count, parse time (us)
+  TRACE_TRACK = 4,            // args: display/radar ID, x/y (cm), z (cm)/vel_z (mm/s)
+  TRACE_INVALID_LENGTH = 5,   // args: packet length
+};
+
+// Trace record: event ID plus raw arguments, decoded only when drained
+struct TraceRecord {
+  uint32_t timestamp;  // micros()
+  uint8_t event;
+  uint32_t args[3];
 };
 
 // Frame Header Structure
@@ -65,10 +214,86 @@ struct TrackData {
   float confidence;    // Track confidence
   bool is_present;     // Presence flag
   bool is_fallen;      // Fall detection flag
-  uint32_t last_seen;  // Frame number last seen
+  uint32_t last_seen;  // Frame number last seen (UINT32_MAX until the first)
+  bool has_height;     // Target height TLV seen this frame
+  float max_height;    // Max Z of the target's points (m)
+  float min_height;    // Min Z of the target's points (m)
+  Posture posture;
+  uint32_t upright_time;  // millis() when max height last reached FALL_UPRIGHT_HEIGHT
+  uint32_t peak_time;     // millis() of peak_height
+  float peak_height;      // Highest max height within FALL_FAST_WINDOW (m)
+  uint8_t lying_frames;   // Consecutive lying frames
+};
+
+// Point cloud in structure-of-arrays layout (room frame, m and m/s)
+struct PointCloud {
+  uint16_t size;
+  float x[MAX_FRAME_POINTS];
+  float y[MAX_FRAME_POINTS];
+  float z[MAX_FRAME_POINTS];
+  float doppler[MAX_FRAME_POINTS];
+  float snr[MAX_FRAME_POINTS];
+};
+
+// Latency samples (us) over the most recent frames
+struct LatencyWindow {
+  std::array<uint32_t, LATENCY_SAMPLES> samples;
+  size_t count;
+  size_t next;
+
+  void add(uint32_t latency) {
+    this->samples[this->next] = latency;
+    this->next = (this->next + 1) % LATENCY_SAMPLES;
+    if (this->count < LATENCY_SAMPLES) {
+      this->count++;
+    }
+  }
+
+  // Percentile (0-100) of the stored samples; copies, so call from diagnostics only
+  uint32_t percentile(float p) const {
+    if (this->count == 0) {
+      return 0;
+    }
+    std::array<uint32_t, LATENCY_SAMPLES> sorted = this->samples;
+    size_t index = std::min(this->count - 1, (size_t) (p / 100.0f * this->count));
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.begin() + this->count);
+    return sorted[index];
+  }
+};
+
+// One decoded frame: header, tracks updated this frame (with display IDs) and points.
+// Passed by const reference to frame callbacks; valid only for the duration of the callback.
+struct RadarFrame {
+  FrameHeader header;
+  int64_t capture_us;   // Radar frame time mapped onto the local clock (see RadarClock)
+  int64_t received_us;  // Magic word found
+  int64_t parsed_us;    // TLVs decoded
+  uint8_t num_tracks;
+  std::array<TrackData, MAX_FRAME_TRACKS> tracks;
+  PointCloud points;
+};
+
+// Target height record (TLV 7)
+struct TargetHeight {
+  uint8_t radar_id;
+  float max_z;
+  float min_z;
 };
 
-// Boundary Configuration
+// Tracks from one tracked-targets TLV in structure-of-arrays layout, transformed to the room frame as a batch
+struct TrackBatch {
+  uint8_t size;
+  uint8_t radar_id[MAX_FRAME_TRACKS];
+  float x[MAX_FRAME_TRACKS];
+  float y[MAX_FRAME_TRACKS];
+  float z[MAX_FRAME_TRACKS];
+  float vel_x[MAX_FRAME_TRACKS];
+  float vel_y[MAX_FRAME_TRACKS];
+  float vel_z[MAX_FRAME_TRACKS];
+  float confidence[MAX_FRAME_TRACKS];
+};
+
+// Boundary Configuration (room frame)
 struct BoundaryBox {
   float x_min;
   float x_max;
@@ -78,12 +303,21 @@ struct BoundaryBox {
   float z_max;
 };
 
+// Dwell-time zone
+struct Zone {
+  std::string name;
+  BoundaryBox box;
+  uint32_t dwell_ms;  // Accumulated person-time inside the zone
+};
+
 // Forward declarations
 class IWR6843Component;
 
-class IWR6843Component : public Component, public spi::SPIDevice<spi::BIT_ORDER_MSB_FIRST, spi::CLOCK_POLARITY_LOW,
-                                                                   spi::CLOCK_PHASE_LEADING, spi::DATA_RATE_2MHZ>,
-                         public uart::UARTDevice {
+// Default SPI rate; overridden at runtime by `data_rate` and auto-tuning
+using IWR6843SPIDevice = spi::SPIDevice<spi::BIT_ORDER_MSB_FIRST, spi::CLOCK_POLARITY_LOW, spi::CLOCK_PHASE_LEADING,
+                                        spi::DATA_RATE_2MHZ>;
+
+class IWR6843Component : public Component, public IWR6843SPIDevice, public uart::UARTDevice {
  public:
   IWR6843Component() = default;
 
@@ -91,6 +325,7 @@ class IWR6843Component : public Component, public spi::SPIDevice<spi::BIT_ORDER_
   void setup() override;
   void loop() override;
   void dump_config() override;
+  void on_safe_shutdown() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
 
   // Pin configuration
@@ -99,13 +334,52 @@ class IWR6843Component : public Component, public spi::SPIDevice<spi::BIT_ORDER_
 
   // Sensor configuration
   void set_ceiling_height(uint16_t height) { this->ceiling_height_ = height; }
+  void set_mounting(float x, float y, float yaw, float pitch, float roll) {
+    this->mounting_x_ = x;
+    this->mounting_y_ = y;
+    this->mounting_yaw_ = yaw;
+    this->mounting_pitch_ = pitch;
+    this->mounting_roll_ = roll;
+  }
+  void update_mounting();
   void set_max_tracks(uint8_t max_tracks) { this->max_tracks_ = max_tracks; }
   void set_tracking_boundary(float x_min, float x_max, float y_min, float y_max, float z_min, float z_max);
   void set_presence_boundary(float x_min, float x_max, float y_min, float y_max, float z_min, float z_max);
+  const BoundaryBox &get_tracking_boundary() const { return this->tracking_boundary_; }
+  const BoundaryBox &get_presence_boundary() const { return this->presence_boundary_; }
+  void update_boundary_config(const std::string &boundary_type);  // Re-send "tracking" or "presence" box
+
+  void set_diagnostics_interval(uint32_t interval) { this->diagnostics_interval_ = interval; }
+  void set_max_recovery_attempts(uint8_t attempts) { this->max_recovery_attempts_ = attempts; }
+  void set_publish_budget(uint32_t budget) { this->publish_budget_ = budget; }
+  void set_clutter_map(uint32_t learning_time, float threshold) {
+    this->clutter_map_enabled_ = true;
+    this->clutter_map_.set_learning_time(learning_time);
+    this->clutter_map_.set_threshold(threshold);
+  }
+  void reset_clutter_map();
+  const ClutterMap &get_clutter_map() const { return this->clutter_map_; }
+  LinkState get_link_state() const { return this->link_state_; }
+  void set_spi_data_rate(uint32_t rate) { this->spi_data_rate_ = rate; }
+  void set_spi_auto_tune(bool auto_tune) { this->spi_auto_tune_ = auto_tune; }
+  void set_spi_max_data_rate(uint32_t rate) { this->spi_max_data_rate_ = rate; }
+  uint32_t get_spi_data_rate() const { return this->spi_data_rate_; }
+  void set_adaptive_frame_rate(uint32_t idle_timeout, float idle_frame_period) {
+    this->adaptive_frame_rate_ = true;
+    this->idle_timeout_ = idle_timeout;
+    this->idle_frame_period_ = idle_frame_period;
+  }
+  bool is_idle_mode() const { return this->idle_mode_; }
 
   // Tracking ID management
   void add_tracking_id(uint8_t id, const std::string &name);
 
+  // Occupancy analytics
+  void add_zone(const std::string &name, float x_min, float x_max, float y_min, float y_max, float z_min,
+                float z_max);
+  const std::array<uint32_t, HEATMAP_GRID_SIZE * HEATMAP_GRID_SIZE> &get_heatmap() const { return this->heatmap_; }
+  void reset_heatmap();
+
   // Sensor registration
   void register_presence_sensor(uint8_t id, binary_sensor::BinarySensor *sensor);
   void register_fall_sensor(uint8_t id, binary_sensor::BinarySensor *sensor);
@@ -113,11 +387,28 @@ class IWR6843Component : public Component, public spi::SPIDevice<spi::BIT_ORDER_
   void register_x_coordinate_sensor(uint8_t id, sensor::Sensor *sensor);
   void register_y_coordinate_sensor(uint8_t id, sensor::Sensor *sensor);
   void register_z_coordinate_sensor(uint8_t id, sensor::Sensor *sensor);
+  void register_height_sensor(uint8_t id, sensor::Sensor *sensor);
+  void register_zone_dwell_sensor(const std::string &zone, sensor::Sensor *sensor);
+  void register_diagnostic_sensor(DiagnosticType type, sensor::Sensor *sensor);
 
   // Control functions
   void reset_sensor();
+  void recover();
   void set_flash_mode(bool enable);
   void send_config_update(const std::string &command);
+  void dump_trace();
+
+  // Frame consumers: called once per decoded frame, no copy or lock needed
+  void add_on_frame_callback(std::function<void(const RadarFrame &)> &&callback) {
+    this->frame_callback_.add(std::move(callback));
+  }
+  const RadarFrame &get_last_frame() const { return this->frames_[this->front_frame_]; }
+
+#ifdef USE_IWR6843_TRAJECTORY
+  // Position history per display ID; read() is safe from other tasks
+  void set_trajectory_buffer_size(size_t size) { this->trajectory_buffer_size_ = size; }
+  const TrajectoryStore &get_trajectory() const { return this->trajectory_; }
+#endif
 
  protected:
   // Hardware pins (CS pin is managed by SPIDevice base class)
@@ -126,6 +417,12 @@ class IWR6843Component : public Component, public spi::SPIDevice<spi::BIT_ORDER_
 
   // Configuration
   uint16_t ceiling_height_{290};  // cm
+  float mounting_x_{0.0f};  // m, room frame
+  float mounting_y_{0.0f};
+  float mounting_yaw_{0.0f};  // degrees
+  float mounting_pitch_{90.0f};  // degrees down from horizontal (90 = ceiling)
+  float mounting_roll_{0.0f};
+  MountingTransform mounting_;
   uint8_t max_tracks_{5};
   BoundaryBox tracking_boundary_;
   BoundaryBox presence_boundary_;
@@ -141,43 +438,208 @@ class IWR6843Component : public Component, public spi::SPIDevice<spi::BIT_ORDER_
   std::map<uint8_t, sensor::Sensor *> x_coordinate_sensors_;
   std::map<uint8_t, sensor::Sensor *> y_coordinate_sensors_;
   std::map<uint8_t, sensor::Sensor *> z_coordinate_sensors_;
+  std::map<uint8_t, sensor::Sensor *> height_sensors_;
+  std::map<std::string, sensor::Sensor *> zone_dwell_sensors_;  // Zone name -> sensor
+  std::map<uint8_t, sensor::Sensor *> diagnostic_sensors_;      // DiagnosticType -> sensor
+
+  // Publish scheduler: one slot per (entity, ID), a newer value replaces the pending one
+  std::array<std::array<float, MAX_FRAME_TRACKS + 1>, PUBLISH_SLOT_COUNT> publish_values_{};
+  std::array<uint8_t, PUBLISH_SLOT_COUNT> publish_pending_{};  // Bit per ID 1-5
+  uint8_t publish_depth_{0};
+  uint8_t publish_peak_depth_{0};  // Since the last diagnostics report
+  uint32_t publish_overruns_{0};
+  uint32_t publish_budget_{DEFAULT_PUBLISH_BUDGET};  // us
+  int64_t publish_capture_us_{0};  // Capture time of the newest frame with pending updates, 0 if none
 
   // Frame parsing
   std::vector<uint8_t> spi_buffer_;
   uint32_t frame_count_{0};
   uint32_t last_frame_time_{0};
 
+  // Decoded frames: parsed into the back buffer, swapped to front once complete
+  std::array<RadarFrame, 2> frames_{};
+  uint8_t front_frame_{0};
+  CallbackManager<void(const RadarFrame &)> frame_callback_;
+  RadarFrame &back_frame_() { return this->frames_[this->front_frame_ ^ 1]; }
+
+  // Link supervisor
+  LinkState link_state_{LINK_STREAMING};
+  uint32_t link_state_since_{0};
+  uint32_t poll_interval_{0};  // ms, 0 while streaming
+  uint32_t next_poll_time_{0};
+  uint8_t recovery_attempts_{0};
+  uint8_t max_recovery_attempts_{5};
+  uint32_t recovery_deadline_{0};  // 0 until the configuration push has finished
+  uint32_t outage_start_{0};
+  bool outage_lost_{false};
+  uint32_t recoveries_{0};
+  uint32_t total_recovery_ms_{0};
+  std::vector<ConfigCommand> config_queue_;
+  size_t config_queue_pos_{0};
+  uint32_t next_config_time_{0};
+
+  // Latency tracing: radar clock alignment and pipeline stamps
+  RadarClock radar_clock_;
+  LatencyWindow parse_latency_{};
+  LatencyWindow publish_latency_{};
+  uint32_t last_frame_number_{0};
+  uint32_t last_micros_{0};
+  int64_t micros_high_{0};
+  int64_t micros64_() {
+    uint32_t now = micros();
+    if (now < this->last_micros_) {
+      this->micros_high_ += int64_t(1) << 32;
+    }
+    this->last_micros_ = now;
+    return this->micros_high_ + now;
+  }
+
+  // SPI link quality and clock auto-tuning
+  uint32_t spi_data_rate_{SPI_SPEED};
+  uint32_t spi_max_data_rate_{MAX_SPI_DATA_RATE};  // Lowered when a rate proves unreliable
+  bool spi_auto_tune_{false};
+  uint32_t spi_sync_losses_{0};
+  uint32_t spi_invalid_frames_{0};
+  uint16_t spi_clean_frames_{0};  // Since last rate change or error
+  uint8_t spi_rate_errors_{0};    // At the current rate
+
+  // Adaptive frame rate
+  bool adaptive_frame_rate_{false};
+  bool idle_mode_{false};
+  uint32_t idle_timeout_{300000};       // ms without tracks before slowing down
+  float idle_frame_period_{500.0f};     // ms
+  float frame_period_{ACTIVE_FRAME_PERIOD};  // ms, currently configured
+  uint8_t frame_num_tracks_{0};         // Tracks reported in the last frame
+  uint32_t last_activity_time_{0};
+  uint32_t mode_start_time_{0};
+  uint32_t mode_start_frame_{0};
+  uint32_t active_mode_ms_{0};
+  uint32_t idle_mode_ms_{0};
+  uint32_t last_reconfig_ms_{0};        // sensorStart to the first frame at the new period
+  float pending_frame_period_{0.0f};    // ms, queued switch, applied when its sensorStart is sent
+  uint32_t reconfig_start_time_{0};     // sensorStart of the last switch, 0 once its first frame arrived
+  uint32_t frames_saved_{0};
+  float avg_frame_bytes_{0.0f};  // Moving averages used to estimate savings
+  float avg_frame_us_{0.0f};
+
+  // Learned static clutter (ghost track suppression), persisted across reboots
+  bool clutter_map_enabled_{false};
+  ClutterMap clutter_map_;
+  ESPPreferenceObject clutter_pref_;
+  uint32_t last_suppressed_tracks_{0};
+  void save_clutter_map_();
+
+  // Occupancy analytics: heatmap cells hold track dwell in ms, updated O(tracks) per frame
+  std::array<uint32_t, HEATMAP_GRID_SIZE * HEATMAP_GRID_SIZE> heatmap_{};
+  std::array<Zone, MAX_ZONES> zones_{};
+  uint8_t num_zones_{0};
+  uint32_t diagnostics_interval_{60000};  // ms
+  uint32_t last_diagnostics_time_{0};
+
+#ifdef USE_IWR6843_TRAJECTORY
+  // Trajectory history (PSRAM when available)
+  TrajectoryStore trajectory_;
+  size_t trajectory_buffer_size_{DEFAULT_TRAJECTORY_BUFFER_SIZE};
+  void record_trajectory_(const RadarFrame &frame);
+#endif
+
+#ifdef USE_IWR6843_TRACE
+  // Binary trace ring (overwrites oldest when full)
+  std::array<TraceRecord, TRACE_BUFFER_SIZE> trace_buffer_{};
+  size_t trace_head_{0};
+  size_t trace_count_{0};
+  uint32_t trace_dropped_{0};
+#endif
+
+  // Tracing (compiles to nothing unless `trace: true`)
+  inline void trace_(TraceEvent event, uint32_t arg0 = 0, uint32_t arg1 = 0, uint32_t arg2 = 0) {
+#ifdef USE_IWR6843_TRACE
+    TraceRecord &record = this->trace_buffer_[(this->trace_head_ + this->trace_count_) & (TRACE_BUFFER_SIZE - 1)];
+    record.timestamp = micros();
+    record.event = event;
+    record.args[0] = arg0;
+    record.args[1] = arg1;
+    record.args[2] = arg2;
+    if (this->trace_count_ < TRACE_BUFFER_SIZE) {
+      this->trace_count_++;
+    } else {
+      this->trace_head_ = (this->trace_head_ + 1) & (TRACE_BUFFER_SIZE - 1);
+      this->trace_dropped_++;
+    }
+#else
+    (void) event;
+    (void) arg0;
+    (void) arg1;
+    (void) arg2;
+#endif
+  }
+  void drain_trace_(size_t max_records);
+
   // SPI communication
+  bool read_frame_();
   bool find_magic_word_spi_();
   bool read_frame_header_(FrameHeader &header);
   bool read_frame_data_(const FrameHeader &header);
   bool parse_tlv_data_(const uint8_t *data, size_t length);
+  void parse_cartesian_points_(const uint8_t *data, size_t length, PointCloud &points);
+  void parse_spherical_points_(const uint8_t *data, size_t length, PointCloud &points);
+  void parse_compressed_points_(const uint8_t *data, size_t length, PointCloud &points);
+  void spi_link_ok_();
+  void spi_link_error_();
+  void apply_spi_data_rate_(uint32_t rate);
 
   // UART communication
+  void write_uart_command_(const std::string &command);
   void send_uart_command_(const std::string &command);
+  void build_sensor_config_(std::vector<ConfigCommand> &commands);
   void initialize_sensor_config_();
-  void update_boundary_config_(const std::string &boundary_type);
+  void pump_config_queue_(uint32_t now);
+
+  // Link supervisor
+  bool should_poll_(uint32_t now);
+  void supervise_link_(uint32_t now, bool frame_processed);
+  void set_link_state_(LinkState state, uint32_t now);
+  void start_recovery_(uint32_t now);
+  void apply_mounting_pose_();
+  std::string boundary_command_(const char *name, const BoundaryBox &box) const;
+  std::string sensor_position_command_() const;
+  std::string frame_cfg_command_(float period) const;
+  std::string tracking_cfg_command_(float period) const;
+  void update_frame_rate_(uint32_t now);
+  void set_frame_period_(float period, uint32_t now);
+  void close_mode_interval_(uint32_t now);
 
   // Data processing
   void process_track_data_(uint8_t radar_id, float x, float y, float z, float vel_x, float vel_y, float vel_z,
                            float confidence);
   void update_sensors_();
   void reset_track_data_(uint8_t id);
+  void queue_publish_(PublishSlot slot, uint8_t id, float value);
+  void publish_slot_(PublishSlot slot, uint8_t id, float value);
+  void drain_publish_queue_();
   void cleanup_old_tracks_();
 
+  // Occupancy analytics and diagnostics
+  void update_occupancy_analytics_(uint32_t frame_dt);
+  void publish_diagnostics_();
+  void publish_diagnostic_(DiagnosticType type, float value);
+
   // Fall detection
-  bool detect_fall_(const TrackData &track);
+  void finalize_frame_tracks_(const TargetHeight *heights, size_t num_heights);
+  Posture classify_posture_(const TrackData &track);
+  bool detect_fall_(TrackData &track);
   std::map<uint8_t, uint32_t> fall_frame_counters_;  // Track ID -> frames since fall
 
   // Helper functions
   uint8_t assign_display_id_(uint8_t radar_id);
   bool is_within_boundary_(float x, float y, float z, const BoundaryBox &box);
+  // last_seen is stamped while a frame is parsed, before frame_count_ counts it
+  bool seen_in_last_frame_(const TrackData &track) const { return track.last_seen + 1 == this->frame_count_; }
   
   // SPI helper to avoid ambiguity with UART methods
   inline void spi_read_array_(uint8_t *data, size_t length) {
     // Explicitly call SPIDevice's read_array via using declaration scope
-    spi::SPIDevice<spi::BIT_ORDER_MSB_FIRST, spi::CLOCK_POLARITY_LOW,
-                   spi::CLOCK_PHASE_LEADING, spi::DATA_RATE_2MHZ>::read_array(data, length);
+    IWR6843SPIDevice::read_array(data, length);
   }
 };
 
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+namespace esphome {
+namespace iwr6843 {
+
+// Sensor mounting pose and the affine transforms into the room frame derived from it.
+//
+// Sensor frame: x right, y boresight, z up (board). The radar is told the mounting height and pitch
+// (`sensorPosition <height> 0 <pitch>`), so its tracker reports in a gravity-aligned frame with the
+// origin on the floor below the sensor, while the point cloud stays in the sensor frame. The room
+// frame adds yaw about z and the mounting x/y offset. Roll, which the tracker cannot model, is folded
+// into both transforms and into the per-target heights (TLV 7). Matrices are rebuilt only when the pose
+// changes; the kernels are branch-free loops over structure-of-arrays batches.
+class MountingTransform {
+ public:
+  // Position in m (height above floor), angles in degrees; pitch is the downward tilt (90 = ceiling)
+  void set_pose(float x, float y, float height, float yaw, float pitch, float roll) {
+    const float deg = 3.14159265f / 180.0f;
+    float cy = cosf(yaw * deg), sy = sinf(yaw * deg);
+    float cp = cosf(pitch * deg), sp = sinf(pitch * deg);
+    float cr = cosf(roll * deg), sr = sinf(roll * deg);
+
+    // Points: Rz(yaw) * Rx(-pitch) * Ry(roll), then translate to (x, y, height)
+    float yaw_m[9] = {cy, -sy, 0.0f, sy, cy, 0.0f, 0.0f, 0.0f, 1.0f};
+    float tilt[9] = {1.0f, 0.0f, 0.0f, 0.0f, cp, sp, 0.0f, -sp, cp};
+    float untilt[9] = {1.0f, 0.0f, 0.0f, 0.0f, cp, -sp, 0.0f, sp, cp};
+    float roll_m[9] = {cr, 0.0f, sr, 0.0f, 1.0f, 0.0f, -sr, 0.0f, cr};
+    float yaw_tilt[9], yaw_tilt_roll[9];
+    multiply_(yaw_m, tilt, yaw_tilt);
+    multiply_(yaw_tilt, roll_m, yaw_tilt_roll);
+    for (int i = 0; i < 9; i++) {
+      this->point_rot_[i] = yaw_tilt_roll[i];
+    }
+    this->point_off_[0] = x;
+    this->point_off_[1] = y;
+    this->point_off_[2] = height;
+
+    // Tracks: undo the tracker's tilt, apply the full rotation; the floor point below the sensor is fixed
+    multiply_(yaw_tilt_roll, untilt, this->track_rot_);
+    for (int i = 0; i < 3; i++) {
+      this->track_off_[i] = this->point_off_[i] - this->track_rot_[i * 3 + 2] * height;
+    }
+    this->tracks_identity_ = x == 0.0f && y == 0.0f && yaw == 0.0f && roll == 0.0f;
+  }
+
+  // Sensor-frame points to room frame, in place
+  void points_to_room(float *x, float *y, float *z, size_t n) const {
+    apply_(this->point_rot_, this->point_off_, x, y, z, n);
+  }
+
+  // Tracker-frame positions and velocities to room frame, in place
+  void tracks_to_room(float *x, float *y, float *z, float *vx, float *vy, float *vz, size_t n) const {
+    if (this->tracks_identity_) {
+      return;
+    }
+    const float zero[3] = {0.0f, 0.0f, 0.0f};
+    apply_(this->track_rot_, this->track_off_, x, y, z, n);
+    apply_(this->track_rot_, zero, vx, vy, vz, n);
+  }
+
+  // Tracker-frame height (TLV 7 max_z/min_z) of the track at room position (x, y, z) to room-frame z
+  float height_to_room(float x, float y, float z, float height) const {
+    if (this->tracks_identity_) {
+      return height;
+    }
+    const float *m = this->track_rot_;
+    float tracker_z = m[2] * (x - this->track_off_[0]) + m[5] * (y - this->track_off_[1]) +
+                      m[8] * (z - this->track_off_[2]);
+    return z + m[8] * (height - tracker_z);
+  }
+
+  // Room-frame position to the tracker frame (for boundaries sent to the radar)
+  void room_to_tracker(float &x, float &y, float &z) const {
+    const float *m = this->track_rot_;
+    float dx = x - this->track_off_[0], dy = y - this->track_off_[1], dz = z - this->track_off_[2];
+    x = m[0] * dx + m[3] * dy + m[6] * dz;
+    y = m[1] * dx + m[4] * dy + m[7] * dz;
+    z = m[2] * dx + m[5] * dy + m[8] * dz;
+  }
+
+ protected:
+  static void multiply_(const float *a, const float *b, float *out) {
+    for (int r = 0; r < 3; r++) {
+      for (int c = 0; c < 3; c++) {
+        out[r * 3 + c] = a[r * 3] * b[c] + a[r * 3 + 1] * b[3 + c] + a[r * 3 + 2] * b[6 + c];
+      }
+    }
+  }
+
+  static void apply_(const float *m, const float *off, float *__restrict x, float *__restrict y,
+                     float *__restrict z, size_t n) {
+    const float m0 = m[0], m1 = m[1], m2 = m[2], m3 = m[3], m4 = m[4], m5 = m[5], m6 = m[6], m7 = m[7], m8 = m[8];
+    const float o0 = off[0], o1 = off[1], o2 = off[2];
+    for (size_t i = 0; i < n; i++) {
+      float px = x[i], py = y[i], pz = z[i];
+      x[i] = m0 * px + m1 * py + m2 * pz + o0;
+      y[i] = m3 * px + m4 * py + m5 * pz + o1;
+      z[i] = m6 * px + m7 * py + m8 * pz + o2;
+    }
+  }
+
+  float point_rot_[9]{1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+  float point_off_[3]{0.0f, 0.0f, 0.0f};
+  float track_rot_[9]{1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+  float track_off_[3]{0.0f, 0.0f, 0.0f};
+  bool tracks_identity_{true};
+};
+
+}  // namespace iwr6843
+}  // namespace esphome
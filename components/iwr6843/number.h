@@ -39,8 +39,7 @@ class IWR6843Number : public number::Number, public Component {
     switch (this->number_type_) {
       case CEILING_HEIGHT:
         this->parent_->set_ceiling_height((uint16_t) value);
-        snprintf(cmd, sizeof(cmd), "sensorPosition %.1f 0 90", value / 100.0f);
-        this->parent_->send_config_update(cmd);
+        this->parent_->update_mounting();  // Keeps the configured tilt and re-sends the boundaries
         break;
         
       case MAX_TRACKS:
@@ -72,20 +71,50 @@ class IWR6843Number : public number::Number, public Component {
     this->publish_state(value);
   }
   
+  // Change the one bound this number controls and re-send the whole box (room frame, m)
   void update_tracking_boundary_(float value) {
-    // This is simplified - in production, you'd need to track all boundary values
-    // and send complete boundaryBox command
-    char cmd[128];
-    snprintf(cmd, sizeof(cmd), "boundaryBox -4 4 -4 4 -0.5 3");  // Use current values
-    this->parent_->send_config_update(cmd);
+    BoundaryBox box = this->parent_->get_tracking_boundary();
+    this->set_bound_(box, value);
+    this->parent_->set_tracking_boundary(box.x_min, box.x_max, box.y_min, box.y_max, box.z_min, box.z_max);
+    this->parent_->update_boundary_config("tracking");
   }
-  
+
   void update_presence_boundary_(float value) {
-    // This is simplified - in production, you'd need to track all boundary values
-    // and send complete presenceBoundaryBox command
-    char cmd[128];
-    snprintf(cmd, sizeof(cmd), "presenceBoundaryBox -4 4 -4 4 0.5 2.5");  // Use current values
-    this->parent_->send_config_update(cmd);
+    BoundaryBox box = this->parent_->get_presence_boundary();
+    this->set_bound_(box, value);
+    this->parent_->set_presence_boundary(box.x_min, box.x_max, box.y_min, box.y_max, box.z_min, box.z_max);
+    this->parent_->update_boundary_config("presence");
+  }
+
+  void set_bound_(BoundaryBox &box, float value) const {
+    switch (this->number_type_) {
+      case TRACKING_BOUNDARY_X_MAX:
+      case PRESENCE_BOUNDARY_X_MAX:
+        box.x_max = value;
+        break;
+      case TRACKING_BOUNDARY_X_MIN:
+      case PRESENCE_BOUNDARY_X_MIN:
+        box.x_min = value;
+        break;
+      case TRACKING_BOUNDARY_Y_MAX:
+      case PRESENCE_BOUNDARY_Y_MAX:
+        box.y_max = value;
+        break;
+      case TRACKING_BOUNDARY_Y_MIN:
+      case PRESENCE_BOUNDARY_Y_MIN:
+        box.y_min = value;
+        break;
+      case TRACKING_BOUNDARY_Z_MAX:
+      case PRESENCE_BOUNDARY_Z_MAX:
+        box.z_max = value;
+        break;
+      case TRACKING_BOUNDARY_Z_MIN:
+      case PRESENCE_BOUNDARY_Z_MIN:
+        box.z_min = value;
+        break;
+      default:
+        break;
+    }
   }
 
   IWR6843Component *parent_{nullptr};
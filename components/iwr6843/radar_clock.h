@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace iwr6843 {
+
+// Maps radar CPU cycle stamps (FrameHeader::time_cpu_cycles) onto the local microsecond clock.
+//
+// The one-way delay from capture to reception is never negative, so the lowest observed
+// (local - radar) offset in each window approximates the fixed part of the pipeline. The slope across
+// the last few window minima gives the drift between the two clocks; a single window pair is too
+// short a baseline against the scatter of the minima.
+class RadarClock {
+ public:
+  static const uint32_t DEFAULT_CPU_MHZ = 200;           // IWR6843 R4F clock
+  static const int64_t WINDOW_US = 10000000;             // Lower-envelope window (radar time)
+  static const int64_t RESYNC_THRESHOLD_US = 500000;     // Offset jump treated as a radar restart
+  static const uint32_t DRIFT_BASELINE_WINDOWS = 6;       // Window minima spanned by one drift slope
+
+  explicit RadarClock(uint32_t cpu_mhz = DEFAULT_CPU_MHZ) : cpu_mhz_(cpu_mhz) {}
+
+  void reset() {
+    this->synced_ = false;
+    this->have_anchor_ = false;
+    this->have_drift_ = false;
+    this->num_minima_ = 0;
+    this->drift_ = 0.0f;
+    this->radar_high_ = 0;
+  }
+
+  // Feed one frame (radar cycle stamp, local receive time); returns the estimated local capture time
+  int64_t update(uint32_t radar_cycles, int64_t local_us) {
+    int64_t radar_us = this->unwrap_(radar_cycles);
+    int64_t offset = local_us - radar_us;
+
+    if (this->synced_ && offset < this->predict_offset_(radar_us) - RESYNC_THRESHOLD_US) {
+      this->reset();  // Radar restarted (cycle counter went back)
+      radar_us = this->unwrap_(radar_cycles);
+      offset = local_us - radar_us;
+    }
+
+    if (!this->synced_) {
+      this->synced_ = true;
+      this->window_start_ = radar_us;
+      this->window_min_offset_ = offset;
+      this->window_min_radar_ = radar_us;
+      this->anchor_offset_ = offset;
+      this->anchor_radar_ = radar_us;
+      return local_us;
+    }
+
+    if (offset < this->window_min_offset_) {
+      this->window_min_offset_ = offset;
+      this->window_min_radar_ = radar_us;
+    }
+    if (!this->have_anchor_ && offset < this->anchor_offset_) {
+      // Until the first window closes, track the running minimum
+      this->anchor_offset_ = offset;
+      this->anchor_radar_ = radar_us;
+    }
+
+    if (radar_us - this->window_start_ >= WINDOW_US) {
+      // Slope from the oldest kept minimum to this one, then push this one into the history
+      uint32_t oldest = this->num_minima_ < DRIFT_BASELINE_WINDOWS ? 0 : this->num_minima_ % DRIFT_BASELINE_WINDOWS;
+      if (this->num_minima_ > 0 && this->window_min_radar_ != this->minima_radar_[oldest]) {
+        float slope = float(this->window_min_offset_ - this->minima_offset_[oldest]) /
+                      float(this->window_min_radar_ - this->minima_radar_[oldest]);
+        this->drift_ = this->have_drift_ ? this->drift_ + (slope - this->drift_) * 0.25f : slope;
+        this->have_drift_ = true;
+      }
+      uint32_t slot = this->num_minima_ % DRIFT_BASELINE_WINDOWS;
+      this->minima_offset_[slot] = this->window_min_offset_;
+      this->minima_radar_[slot] = this->window_min_radar_;
+      this->num_minima_++;
+
+      this->anchor_offset_ = this->window_min_offset_;
+      this->anchor_radar_ = this->window_min_radar_;
+      this->have_anchor_ = true;
+      this->window_start_ = radar_us;
+      this->window_min_offset_ = offset;
+      this->window_min_radar_ = radar_us;
+    }
+
+    return radar_us + this->predict_offset_(radar_us);
+  }
+
+  bool is_synced() const { return this->synced_; }
+  float drift_ppm() const { return this->drift_ * 1e6f; }
+
+ protected:
+  int64_t unwrap_(uint32_t cycles) {
+    if (this->synced_ && cycles < this->last_cycles_) {
+      this->radar_high_ += int64_t(1) << 32;  // 32-bit cycle counter wrapped (~21 s at 200 MHz)
+    }
+    this->last_cycles_ = cycles;
+    return (this->radar_high_ + cycles) / this->cpu_mhz_;
+  }
+
+  int64_t predict_offset_(int64_t radar_us) const {
+    return this->anchor_offset_ + int64_t(this->drift_ * float(radar_us - this->anchor_radar_));
+  }
+
+  uint32_t cpu_mhz_;
+  bool synced_{false};
+  bool have_anchor_{false};
+  bool have_drift_{false};
+  float drift_{0.0f};  // Local seconds gained per radar second
+  uint32_t last_cycles_{0};
+  int64_t radar_high_{0};
+  int64_t window_start_{0};
+  int64_t window_min_offset_{0};
+  int64_t window_min_radar_{0};
+  int64_t anchor_offset_{0};
+  int64_t anchor_radar_{0};
+  int64_t minima_offset_[DRIFT_BASELINE_WINDOWS]{};
+  int64_t minima_radar_[DRIFT_BASELINE_WINDOWS]{};
+  uint32_t num_minima_{0};
+};
+
+}  // namespace iwr6843
+}  // namespace esphome
@@ -1,18 +1,32 @@
 """IWR6843 Sensor Platform"""
 import esphome.codegen as cg
 import esphome.config_validation as cv
+import esphome.final_validate as fv
 from esphome.components import sensor
 from esphome.const import (
-    CONF_ID,
+    CONF_NAME,
+    DEVICE_CLASS_DURATION,
+    ENTITY_CATEGORY_DIAGNOSTIC,
     STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
     UNIT_CENTIMETER,
+    UNIT_MILLISECOND,
+    UNIT_PERCENT,
+    UNIT_SECOND,
 )
-from . import IWR6843Component, CONF_IWR6843_ID, iwr6843_ns
+from . import IWR6843Component, CONF_IWR6843_ID, CONF_ZONES, iwr6843_ns
 
 DEPENDENCIES = ["iwr6843"]
 
 CONF_PERSON_ID = "person_id"
 CONF_COORDINATE_TYPE = "coordinate_type"
+CONF_ZONE = "zone"
+CONF_DIAGNOSTIC_TYPE = "diagnostic_type"
+
+UNIT_MEGAHERTZ = "MHz"
+UNIT_KILOBYTES = "KB"
+UNIT_PARTS_PER_MILLION = "ppm"
+UNIT_TRACKS_PER_HOUR = "tracks/h"
 
 CoordinateType = iwr6843_ns.enum("CoordinateType")
 COORDINATE_TYPES = {
@@ -20,32 +34,218 @@ COORDINATE_TYPES = {
     "y": CoordinateType.Y_COORDINATE,
     "z": CoordinateType.Z_COORDINATE,
     "velocity": CoordinateType.VELOCITY,
+    "height": CoordinateType.HEIGHT,
 }
 
-CONFIG_SCHEMA = sensor.sensor_schema(
-    unit_of_measurement=UNIT_CENTIMETER,
-    icon="mdi:ruler",
-    accuracy_decimals=2,
-    state_class=STATE_CLASS_MEASUREMENT,
-).extend(
+DiagnosticType = iwr6843_ns.enum("DiagnosticType")
+DIAGNOSTIC_TYPES = {
+    "heatmap_peak_x": DiagnosticType.HEATMAP_PEAK_X,
+    "heatmap_peak_y": DiagnosticType.HEATMAP_PEAK_Y,
+    "heatmap_coverage": DiagnosticType.HEATMAP_COVERAGE,
+    "spi_data_rate": DiagnosticType.SPI_DATA_RATE,
+    "spi_sync_losses": DiagnosticType.SPI_SYNC_LOSSES,
+    "spi_invalid_frames": DiagnosticType.SPI_INVALID_FRAMES,
+    "active_mode_time": DiagnosticType.ACTIVE_MODE_TIME,
+    "idle_mode_time": DiagnosticType.IDLE_MODE_TIME,
+    "reconfig_time": DiagnosticType.RECONFIG_TIME,
+    "frames_saved": DiagnosticType.FRAMES_SAVED,
+    "cpu_time_saved": DiagnosticType.CPU_TIME_SAVED,
+    "spi_bytes_saved": DiagnosticType.SPI_BYTES_SAVED,
+    "latency_parse_p50": DiagnosticType.LATENCY_PARSE_P50,
+    "latency_parse_p95": DiagnosticType.LATENCY_PARSE_P95,
+    "latency_publish_p50": DiagnosticType.LATENCY_PUBLISH_P50,
+    "latency_publish_p95": DiagnosticType.LATENCY_PUBLISH_P95,
+    "clock_drift": DiagnosticType.CLOCK_DRIFT,
+    "link_state": DiagnosticType.LINK_STATE,
+    "mean_time_to_recovery": DiagnosticType.MEAN_TIME_TO_RECOVERY,
+    "publish_queue_depth": DiagnosticType.PUBLISH_QUEUE_DEPTH,
+    "publish_overruns": DiagnosticType.PUBLISH_OVERRUNS,
+    "clutter_cells": DiagnosticType.CLUTTER_CELLS,
+    "suppressed_tracks_per_hour": DiagnosticType.SUPPRESSED_TRACKS_PER_HOUR,
+}
+
+PARENT_SCHEMA = cv.Schema(
     {
         cv.GenerateID(CONF_IWR6843_ID): cv.use_id(IWR6843Component),
-        cv.Required(CONF_PERSON_ID): cv.int_range(min=1, max=5),
-        cv.Optional(CONF_COORDINATE_TYPE, default="x"): cv.enum(
-            COORDINATE_TYPES, lower=True
-        ),
     }
 )
 
 
+def diagnostic_schema(
+    unit=cv.UNDEFINED,
+    icon=cv.UNDEFINED,
+    accuracy_decimals=0,
+    state_class=STATE_CLASS_MEASUREMENT,
+    device_class=cv.UNDEFINED,
+):
+    """Sensor schema for one diagnostic type"""
+    return sensor.sensor_schema(
+        unit_of_measurement=unit,
+        icon=icon,
+        accuracy_decimals=accuracy_decimals,
+        state_class=state_class,
+        device_class=device_class,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ).extend(PARENT_SCHEMA)
+
+
+DIAGNOSTIC_SCHEMAS = {
+    "heatmap_peak_x": diagnostic_schema(UNIT_CENTIMETER, "mdi:map-marker"),
+    "heatmap_peak_y": diagnostic_schema(UNIT_CENTIMETER, "mdi:map-marker"),
+    "heatmap_coverage": diagnostic_schema(UNIT_PERCENT, "mdi:grid", 1),
+    "spi_data_rate": diagnostic_schema(UNIT_MEGAHERTZ, "mdi:sine-wave", 1),
+    "spi_sync_losses": diagnostic_schema(
+        icon="mdi:sync-alert", state_class=STATE_CLASS_TOTAL_INCREASING
+    ),
+    "spi_invalid_frames": diagnostic_schema(
+        icon="mdi:alert-circle-outline", state_class=STATE_CLASS_TOTAL_INCREASING
+    ),
+    "active_mode_time": diagnostic_schema(
+        UNIT_SECOND,
+        "mdi:timer-outline",
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        device_class=DEVICE_CLASS_DURATION,
+    ),
+    "idle_mode_time": diagnostic_schema(
+        UNIT_SECOND,
+        "mdi:timer-sand-paused",
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        device_class=DEVICE_CLASS_DURATION,
+    ),
+    "reconfig_time": diagnostic_schema(
+        UNIT_MILLISECOND, "mdi:timer-cog-outline", device_class=DEVICE_CLASS_DURATION
+    ),
+    "frames_saved": diagnostic_schema(
+        icon="mdi:leaf", state_class=STATE_CLASS_TOTAL_INCREASING
+    ),
+    "cpu_time_saved": diagnostic_schema(
+        UNIT_SECOND,
+        "mdi:leaf",
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        device_class=DEVICE_CLASS_DURATION,
+    ),
+    "spi_bytes_saved": diagnostic_schema(
+        UNIT_KILOBYTES, "mdi:leaf", state_class=STATE_CLASS_TOTAL_INCREASING
+    ),
+    "latency_parse_p50": diagnostic_schema(
+        UNIT_MILLISECOND, "mdi:timer-sand", 1, device_class=DEVICE_CLASS_DURATION
+    ),
+    "latency_parse_p95": diagnostic_schema(
+        UNIT_MILLISECOND, "mdi:timer-sand", 1, device_class=DEVICE_CLASS_DURATION
+    ),
+    "latency_publish_p50": diagnostic_schema(
+        UNIT_MILLISECOND, "mdi:timer-sand", 1, device_class=DEVICE_CLASS_DURATION
+    ),
+    "latency_publish_p95": diagnostic_schema(
+        UNIT_MILLISECOND, "mdi:timer-sand", 1, device_class=DEVICE_CLASS_DURATION
+    ),
+    "clock_drift": diagnostic_schema(UNIT_PARTS_PER_MILLION, "mdi:clock-alert-outline", 1),
+    # 0 streaming, 1 degraded, 2 lost, 3 recovering; a state, not a measurement
+    "link_state": diagnostic_schema(icon="mdi:lan-connect", state_class=cv.UNDEFINED),
+    "mean_time_to_recovery": diagnostic_schema(
+        UNIT_SECOND, "mdi:restart", 1, device_class=DEVICE_CLASS_DURATION
+    ),
+    "publish_queue_depth": diagnostic_schema(icon="mdi:tray-full"),
+    "publish_overruns": diagnostic_schema(
+        icon="mdi:tray-alert", state_class=STATE_CLASS_TOTAL_INCREASING
+    ),
+    "clutter_cells": diagnostic_schema(icon="mdi:grid"),
+    "suppressed_tracks_per_hour": diagnostic_schema(
+        UNIT_TRACKS_PER_HOUR, "mdi:ghost-off", 1
+    ),
+}
+
+COORDINATE_SCHEMA = (
+    sensor.sensor_schema(
+        unit_of_measurement=UNIT_CENTIMETER,
+        icon="mdi:ruler",
+        accuracy_decimals=2,
+        state_class=STATE_CLASS_MEASUREMENT,
+    )
+    .extend(PARENT_SCHEMA)
+    .extend(
+        {
+            cv.Required(CONF_PERSON_ID): cv.int_range(min=1, max=5),
+            cv.Optional(CONF_COORDINATE_TYPE, default="x"): cv.enum(
+                COORDINATE_TYPES, lower=True
+            ),
+        }
+    )
+)
+
+ZONE_SCHEMA = (
+    sensor.sensor_schema(
+        unit_of_measurement=UNIT_SECOND,
+        icon="mdi:sofa",
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        device_class=DEVICE_CLASS_DURATION,
+    )
+    .extend(PARENT_SCHEMA)
+    .extend(
+        {
+            cv.Required(CONF_ZONE): cv.string,
+        }
+    )
+)
+
+DIAGNOSTIC_SCHEMA = cv.typed_schema(
+    DIAGNOSTIC_SCHEMAS, key=CONF_DIAGNOSTIC_TYPE, lower=True
+)
+
+
+def validate_sensor(config):
+    """Validate against the schema for the kind of sensor configured"""
+    if CONF_ZONE in config:
+        return ZONE_SCHEMA(config)
+    if CONF_DIAGNOSTIC_TYPE in config:
+        return DIAGNOSTIC_SCHEMA(config)
+    return COORDINATE_SCHEMA(config)
+
+
+# One of: per-person coordinate, zone dwell time (s), or component diagnostic
+CONFIG_SCHEMA = cv.All(
+    cv.has_exactly_one_key(CONF_PERSON_ID, CONF_ZONE, CONF_DIAGNOSTIC_TYPE),
+    validate_sensor,
+)
+
+
+def final_validate_zone(config):
+    """Zone sensors must name a zone defined on their iwr6843 component"""
+    if CONF_ZONE not in config:
+        return config
+    full_config = fv.full_config.get()
+    parent_path = full_config.get_path_for_id(config[CONF_IWR6843_ID])[:-1]
+    parent_config = full_config.get_config_for_path(parent_path)
+    names = [zone[CONF_NAME] for zone in parent_config.get(CONF_ZONES, [])]
+    if config[CONF_ZONE] not in names:
+        raise cv.Invalid(
+            f"Zone '{config[CONF_ZONE]}' is not defined in zones "
+            f"(defined: {', '.join(names) if names else 'none'})",
+            path=[CONF_ZONE],
+        )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = final_validate_zone
+
+
 async def to_code(config):
     """Generate sensor code"""
     parent = await cg.get_variable(config[CONF_IWR6843_ID])
     sens = await sensor.new_sensor(config)
-    
+
+    if CONF_ZONE in config:
+        cg.add(parent.register_zone_dwell_sensor(config[CONF_ZONE], sens))
+        return
+
+    if CONF_DIAGNOSTIC_TYPE in config:
+        cg.add(parent.register_diagnostic_sensor(config[CONF_DIAGNOSTIC_TYPE], sens))
+        return
+
     person_id = config[CONF_PERSON_ID]
     coord_type = config[CONF_COORDINATE_TYPE]
-    
+
     if coord_type == "x":
         cg.add(parent.register_x_coordinate_sensor(person_id, sens))
     elif coord_type == "y":
@@ -54,4 +254,5 @@ async def to_code(config):
         cg.add(parent.register_z_coordinate_sensor(person_id, sens))
     elif coord_type == "velocity":
         cg.add(parent.register_velocity_sensor(person_id, sens))
-
+    elif coord_type == "height":
+        cg.add(parent.register_height_sensor(person_id, sens))
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_IWR6843_TRAJECTORY
+
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/web_server_base/web_server_base.h"
+#include "iwr6843.h"
+
+namespace esphome {
+namespace iwr6843 {
+
+// GET /iwr6843/trajectory?id=<1-5>&window=<s, default 600>
+//
+// text/plain: "now <millis>" then one base64 line per TrajectoryStore block, oldest first. Runs in
+// the web server task and only copies blocks out of the store, so frame processing never waits.
+class TrajectoryHandler : public AsyncWebHandler {
+ public:
+  explicit TrajectoryHandler(IWR6843Component *parent) : parent_(parent) {}
+
+  bool canHandle(AsyncWebServerRequest *request) const override {
+    return request->method() == HTTP_GET && request->url() == "/iwr6843/trajectory";
+  }
+
+  void handleRequest(AsyncWebServerRequest *request) override {
+    auto id = parse_number<uint8_t>(request->arg("id").c_str());
+    if (!id.has_value() || *id < 1 || *id > TrajectoryStore::MAX_TRACKS) {
+      request->send(400, "text/plain", "id must be 1-5");
+      return;
+    }
+    uint32_t window = parse_number<uint32_t>(request->arg("window").c_str()).value_or(600);
+    if (window > TrajectoryStore::MAX_WINDOW_S) {
+      window = TrajectoryStore::MAX_WINDOW_S;  // Larger windows overflow in ms
+    }
+
+    uint32_t now = millis();
+    AsyncResponseStream *stream = request->beginResponseStream("text/plain");
+    stream->printf("now %u\n", now);
+    this->parent_->get_trajectory().read(*id - 1, now, window * 1000, [stream](const uint8_t *data, size_t length) {
+      stream->print(base64_encode(data, length).c_str());
+      stream->print("\n");
+    });
+    request->send(stream);
+  }
+
+ protected:
+  IWR6843Component *parent_;
+};
+
+}  // namespace iwr6843
+}  // namespace esphome
+
+#endif  // USE_IWR6843_TRAJECTORY
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace esphome {
+namespace iwr6843 {
+
+// Bounded per-track position history, delta-encoded into fixed-size blocks.
+//
+// Each block opens with a keyframe (uint32 time in ms, int16 x/y/z in cm, little-endian) followed by
+// samples: varint (dt_ms << 1 | moved) and, when moved, zigzag varints of the x/y/z change in cm. At
+// 120 ms frames a walking person costs about 5.1 bytes per sample, a still one 2.1 (the time varint
+// alone is 2). When a track's blocks are full its oldest block is reused. The frame loop is the only
+// writer; readers copy whole blocks under a per-block sequence counter and retry on a torn copy, so
+// they never make the writer wait.
+class TrajectoryStore {
+ public:
+  static const uint8_t MAX_TRACKS = 5;           // Display IDs 1-5 (index 0-4)
+  static const size_t BLOCK_SIZE = 256;          // Bytes per block, keyframe included
+  static const size_t KEYFRAME_SIZE = 10;
+  static const size_t MAX_SAMPLE_SIZE = 12;      // 3-byte time varint + 3 x 3-byte deltas
+  static const uint32_t MAX_SAMPLE_GAP = 65535;  // ms, longer gaps start a new block
+  static const uint32_t MAX_WINDOW_S = UINT32_MAX / 1000;  // Ages are millis() differences, so wrap-bounded
+
+  ~TrajectoryStore() { delete[] this->blocks_; }
+
+  // Use `buffer` (not owned) for block data; returns false if it is too small for one block per track
+  bool init(uint8_t *buffer, size_t size) {
+    delete[] this->blocks_;
+    this->blocks_ = nullptr;
+    this->blocks_per_track_ = size / BLOCK_SIZE / MAX_TRACKS;
+    if (this->blocks_per_track_ == 0) {
+      return false;
+    }
+    this->data_ = buffer;
+    this->blocks_ = new Block[this->blocks_per_track_ * MAX_TRACKS];
+    for (auto &track : this->tracks_) {
+      track.open = false;
+      track.newest.store(0);
+      track.count.store(0);
+    }
+    return true;
+  }
+
+  size_t capacity() const { return this->blocks_per_track_ * MAX_TRACKS * BLOCK_SIZE; }
+
+  // Append a position (m); writer side, frame loop only
+  void add(uint8_t track, uint32_t now_ms, float x, float y, float z) {
+    if (track >= MAX_TRACKS || this->blocks_ == nullptr) {
+      return;
+    }
+    TrackState &state = this->tracks_[track];
+    int16_t qx = quantize_(x);
+    int16_t qy = quantize_(y);
+    int16_t qz = quantize_(z);
+
+    uint8_t sample[MAX_SAMPLE_SIZE];
+    size_t len = 0;
+    uint32_t dt = now_ms - state.last_ms;
+    if (state.open && dt <= MAX_SAMPLE_GAP) {
+      bool moved = qx != state.x || qy != state.y || qz != state.z;
+      len = put_varint_(sample, (dt << 1) | moved);
+      if (moved) {
+        len += put_varint_(sample + len, zigzag_(qx - state.x));
+        len += put_varint_(sample + len, zigzag_(qy - state.y));
+        len += put_varint_(sample + len, zigzag_(qz - state.z));
+      }
+    }
+
+    size_t index = this->block_index_(track, state.newest.load(std::memory_order_relaxed));
+    if (len != 0 && this->blocks_[index].used.load(std::memory_order_relaxed) + len <= BLOCK_SIZE) {
+      Block &block = this->blocks_[index];
+      uint16_t used = block.used.load(std::memory_order_relaxed);
+      begin_write_(block);
+      std::memcpy(this->data_ + index * BLOCK_SIZE + used, sample, len);
+      block.used.store(used + len, std::memory_order_relaxed);
+      block.last_ms.store(now_ms, std::memory_order_relaxed);
+      end_write_(block);
+    } else {
+      this->open_block_(track, state, now_ms, qx, qy, qz);
+    }
+
+    state.open = true;
+    state.last_ms = now_ms;
+    state.x = qx;
+    state.y = qy;
+    state.z = qz;
+  }
+
+  // Track left the scene; the next position starts a new block (display IDs are reused)
+  void end(uint8_t track) {
+    if (track < MAX_TRACKS) {
+      this->tracks_[track].open = false;
+    }
+  }
+
+  // Copy each block of `track` with a sample in the last `window_ms`, oldest first, and pass it to
+  // callback(const uint8_t *data, size_t length). Reader side, safe from any task.
+  template<typename F> void read(uint8_t track, uint32_t now_ms, uint32_t window_ms, F &&callback) const {
+    if (track >= MAX_TRACKS || this->blocks_ == nullptr) {
+      return;
+    }
+    const TrackState &state = this->tracks_[track];
+    uint16_t count = state.count.load(std::memory_order_acquire);
+    uint16_t newest = state.newest.load(std::memory_order_acquire);
+    uint8_t copy[BLOCK_SIZE];
+    for (uint16_t i = count; i > 0; i--) {
+      size_t index = this->block_index_(track, (newest + this->blocks_per_track_ + 1 - i) % this->blocks_per_track_);
+      uint16_t used;
+      uint32_t last_ms;
+      if (this->copy_block_(index, copy, used, last_ms) && now_ms - last_ms <= window_ms) {
+        callback(copy, (size_t) used);
+      }
+    }
+  }
+
+ protected:
+  struct Block {
+    std::atomic<uint32_t> seq{0};  // Odd while being written
+    std::atomic<uint16_t> used{0};
+    std::atomic<uint32_t> last_ms{0};  // Newest sample
+  };
+
+  struct TrackState {
+    bool open{false};
+    uint32_t last_ms{0};
+    int16_t x{0};
+    int16_t y{0};
+    int16_t z{0};
+    std::atomic<uint16_t> newest{0};  // Slot of the block being appended to
+    std::atomic<uint16_t> count{0};   // Blocks holding data
+  };
+
+  size_t block_index_(uint8_t track, uint16_t slot) const { return track * this->blocks_per_track_ + slot; }
+
+  void open_block_(uint8_t track, TrackState &state, uint32_t now_ms, int16_t x, int16_t y, int16_t z) {
+    uint16_t count = state.count.load(std::memory_order_relaxed);
+    uint16_t slot = count == 0 ? 0 : (state.newest.load(std::memory_order_relaxed) + 1) % this->blocks_per_track_;
+    size_t index = this->block_index_(track, slot);
+    Block &block = this->blocks_[index];
+    uint8_t *data = this->data_ + index * BLOCK_SIZE;
+
+    begin_write_(block);
+    put_u32_(data, now_ms);
+    put_u16_(data + 4, x);
+    put_u16_(data + 6, y);
+    put_u16_(data + 8, z);
+    block.used.store(KEYFRAME_SIZE, std::memory_order_relaxed);
+    block.last_ms.store(now_ms, std::memory_order_relaxed);
+    end_write_(block);
+
+    state.newest.store(slot, std::memory_order_release);
+    if (count < this->blocks_per_track_) {
+      state.count.store(count + 1, std::memory_order_release);
+    }
+  }
+
+  bool copy_block_(size_t index, uint8_t *out, uint16_t &used, uint32_t &last_ms) const {
+    const Block &block = this->blocks_[index];
+    for (uint8_t attempt = 0; attempt < 4; attempt++) {
+      uint32_t seq = block.seq.load(std::memory_order_acquire);
+      if (seq & 1) {
+        continue;  // Writer mid-update
+      }
+      used = std::min<uint16_t>(block.used.load(std::memory_order_relaxed), BLOCK_SIZE);
+      last_ms = block.last_ms.load(std::memory_order_relaxed);
+      std::memcpy(out, this->data_ + index * BLOCK_SIZE, used);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (block.seq.load(std::memory_order_relaxed) == seq) {
+        return used >= KEYFRAME_SIZE;
+      }
+    }
+    return false;
+  }
+
+  static void begin_write_(Block &block) {
+    block.seq.store(block.seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+  static void end_write_(Block &block) {
+    block.seq.store(block.seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  static int16_t quantize_(float value) {
+    return (int16_t) std::max(-32767.0f, std::min(32767.0f, std::round(value * 100.0f)));  // m to cm
+  }
+  static uint32_t zigzag_(int32_t value) { return ((uint32_t) value << 1) ^ (uint32_t) (value >> 31); }
+  static size_t put_varint_(uint8_t *out, uint32_t value) {
+    size_t len = 0;
+    while (value >= 0x80) {
+      out[len++] = (uint8_t) (value | 0x80);
+      value >>= 7;
+    }
+    out[len++] = (uint8_t) value;
+    return len;
+  }
+  static void put_u16_(uint8_t *out, int16_t value) {
+    out[0] = (uint8_t) value;
+    out[1] = (uint8_t) ((uint16_t) value >> 8);
+  }
+  static void put_u32_(uint8_t *out, uint32_t value) {
+    for (uint8_t i = 0; i < 4; i++) {
+      out[i] = (uint8_t) (value >> (8 * i));
+    }
+  }
+
+  uint8_t *data_{nullptr};
+  Block *blocks_{nullptr};
+  size_t blocks_per_track_{0};
+  TrackState tracks_[MAX_TRACKS];
+};
+
+}  // namespace iwr6843
+}  // namespace esphome
@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""Clutter map replay: scripted rooms with clutter sources through the simulator and the host frame harness.
+
+Each tests/clutter_scripts/*.json is a simulator script (targets and fixed "ghosts") plus an "expect" block:
+    "expect": {"learned_after": 1200,       # s, judge ghosts from here on (map has learned)
+               "min_real_shown": 0.99,      # each scripted target holds a display ID in this share of frames
+               "max_ghost_shown": 0.005}    # ghost display frames after learned_after, per frame
+
+The simulator writes points in the sensor frame (default ceiling pose), so the learned cells also show that the
+cloud reaches the map in room coordinates: every clutter cell must lie at a scripted ghost and every ghost must
+have one. Exits non-zero if any scenario fails.
+
+    tests/clutter_replay.py [--harness tests/build/frame_harness] [--build tests/build]
+"""
+import argparse
+import glob
+import json
+import math
+import os
+import subprocess
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SIM = os.path.join(HERE, "..", "tools", "iwr6843_sim.py")
+GHOST_ID_BASE = 100  # Simulator ghost track IDs
+CELL_RADIUS = 0.5  # m, how far a learned cell may sit from its clutter source
+
+
+def run_scenario(path, harness, build):
+    with open(path, encoding="utf-8") as f:
+        scenario = json.load(f)
+    name = os.path.splitext(os.path.basename(path))[0]
+    capture = os.path.join(build, f"clutter_{name}.bin")
+    subprocess.run(
+        [sys.executable, SIM, "frames", "--script", path, "--duration", str(scenario["duration"]),
+         "--no-realtime", "--seed", "1", "-o", capture],
+        check=True,
+        stderr=subprocess.DEVNULL,
+    )
+    output = subprocess.run([harness, capture, "--clutter"], check=True, capture_output=True, text=True).stdout
+
+    expect = scenario["expect"]
+    learned_after = expect["learned_after"]
+    cells, shown_real, frames = [], {}, 0
+    ghost_frames = dropped = 0
+    for line in output.splitlines():
+        kind, *fields = line.split(",")
+        if kind == "clutter_cell":
+            cells.append((float(fields[0]), float(fields[1])))
+        elif kind == "shown" and int(fields[1]) < GHOST_ID_BASE:
+            shown_real[int(fields[1])] = shown_real.get(int(fields[1]), 0) + int(fields[2])
+        elif kind == "shown" and float(fields[0]) >= learned_after:
+            ghost_frames += int(fields[2])
+        elif kind == "suppressed" and float(fields[0]) >= learned_after:
+            dropped += 1
+        elif kind == "frames":
+            frames = int(fields[0])
+
+    problems = []
+    ghosts = scenario.get("ghosts", [])
+    stray = [c for c in cells if not any(math.dist(c, g) <= CELL_RADIUS for g in ghosts)]
+    missed = [g for g in ghosts if not any(math.dist(c, g) <= CELL_RADIUS for c in cells)]
+    if stray:
+        problems.append(f"clutter cells away from any source: {stray}")
+    if missed:
+        problems.append(f"sources never learned: {missed}")
+    for tid in range(len(scenario["targets"])):
+        share = shown_real.get(tid, 0) / max(frames, 1)
+        if share < expect["min_real_shown"]:
+            problems.append(f"target {tid} shown in {share:.1%} of frames")
+    learned_frames = frames * (1.0 - learned_after / scenario["duration"])
+    ghost_share = ghost_frames / max(learned_frames, 1.0)
+    if ghost_share > expect["max_ghost_shown"]:
+        problems.append(f"ghosts shown in {ghost_share:.2%} of frames after learning")
+
+    detail = (f"{len(cells)} clutter cells, real tracks shown "
+              f"{min(shown_real.values(), default=0) / max(frames, 1):.2%}+ of frames; after {learned_after} s "
+              f"{dropped} ghosts dropped, ghost display {ghost_frames} frames ({ghost_share:.2%})")
+    return name, not problems, detail, problems
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--harness", default=os.path.join(HERE, "build", "frame_harness"))
+    parser.add_argument("--build", default=os.path.join(HERE, "build"))
+    args = parser.parse_args()
+
+    failures = 0
+    for path in sorted(glob.glob(os.path.join(HERE, "clutter_scripts", "*.json"))):
+        name, ok, detail, problems = run_scenario(path, args.harness, args.build)
+        print(f"{'ok  ' if ok else 'FAIL'} {name:14} {detail}")
+        for problem in problems:
+            print(f"     {problem}")
+        failures += not ok
+    print(f"clutter_replay: {'PASS' if failures == 0 else 'FAIL'}")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
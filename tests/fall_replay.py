@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+"""Fall detection replay: scripted scenarios through the simulator and the host frame harness.
+
+Each tests/fall_scripts/*.json is a simulator script plus an "expect" block:
+    "expect": {"fall_at": 10.0, "max_latency": 0.3}   # fall on the floor at 10 s, alert within 0.3 s
+    "expect": {"fall_at": null}                       # no fall alert allowed (false-alarm check)
+    "expect": {..., "held": true}                     # and the alert must not clear before the end
+
+The scenario is rendered with tools/iwr6843_sim.py, replayed with `frame_harness --events`, and the first
+fall alert is compared with the expectation. Exits non-zero if any scenario fails.
+
+    tests/fall_replay.py [--harness tests/build/frame_harness] [--build tests/build]
+"""
+import argparse
+import glob
+import json
+import os
+import subprocess
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SIM = os.path.join(HERE, "..", "tools", "iwr6843_sim.py")
+
+
+def run_scenario(path, harness, build):
+    with open(path, encoding="utf-8") as f:
+        scenario = json.load(f)
+    name = os.path.splitext(os.path.basename(path))[0]
+    capture = os.path.join(build, f"fall_{name}.bin")
+    subprocess.run(
+        [sys.executable, SIM, "frames", "--script", path, "--duration", str(scenario["duration"]),
+         "--no-realtime", "--seed", "1", "-o", capture],
+        check=True,
+        stderr=subprocess.DEVNULL,
+    )
+    output = subprocess.run([harness, capture, "--events"], check=True, capture_output=True, text=True).stdout
+    falls = [float(line.split(",")[1]) for line in output.splitlines() if line.startswith("fall,")]
+    clears = [float(line.split(",")[1]) for line in output.splitlines() if line.startswith("clear,")]
+
+    expect = scenario["expect"]
+    if expect["fall_at"] is None:
+        ok = not falls
+        detail = "no alert" if ok else f"false alarm at {falls[0]:.2f} s"
+    elif not falls:
+        ok, detail = False, "missed"
+    else:
+        latency = falls[0] - expect["fall_at"]
+        ok = 0.0 <= latency <= expect["max_latency"]
+        detail = f"alert at {falls[0]:.2f} s, latency {latency * 1000:.0f} ms (limit {expect['max_latency'] * 1000:.0f} ms)"
+        if expect.get("held") and clears:
+            ok = False
+            detail += f", cleared at {clears[0]:.2f} s"
+    return name, ok, detail, len(falls)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--harness", default=os.path.join(HERE, "build", "frame_harness"))
+    parser.add_argument("--build", default=os.path.join(HERE, "build"))
+    args = parser.parse_args()
+
+    failures = 0
+    for path in sorted(glob.glob(os.path.join(HERE, "fall_scripts", "*.json"))):
+        name, ok, detail, alerts = run_scenario(path, args.harness, args.build)
+        print(f"{'ok  ' if ok else 'FAIL'} {name:14} {detail} ({alerts} alert{'s' if alerts != 1 else ''})")
+        failures += not ok
+    print(f"fall_replay: {'PASS' if failures == 0 else 'FAIL'}")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,161 @@
+// Frame harness: replays a simulator capture through the component's SPI read path (magic word search,
+// header, parse_tlv_data_, analytics, sensor updates) and the publish scheduler, and reports host time
+// per frame. Host timings are for relative comparison between changes, not ESP32 numbers.
+//
+// SPI transfers take simulated time at the configured data rate, and each frame is received 5 ms after
+// its radar timestamp. The radar clock's lower envelope absorbs that fixed delay, so the component's
+// capture-to-parse p50 must come out no larger than the simulated SPI time per frame over the same
+// (most recent) frames; the harness fails otherwise.
+//
+//   build/frame_harness capture.bin [--per-frame | --events | --clutter] [-v]
+//
+// --events prints fall alerts as they are published: "fall,<capture time s>,<display id>" (and "clear,...").
+// --clutter enables the clutter map (default learning_time and threshold) and prints
+//   "shown,<t s>,<radar id>,<frames>"   a radar track held a display ID from t for `frames` frames
+//   "suppressed,<t s>"                  the map dropped a new track
+//   "clutter_cell,<x>,<y>,<score>"      at the end, each learned cell by its room-frame centre
+//   "frames,<n>"                        at the end, parsed frames
+
+#include "host_radar.h"
+
+#include <cstdlib>
+#include <map>
+#include <string>
+
+using namespace esphome;
+using namespace esphome::iwr6843;
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s capture.bin [--per-frame | --events | --clutter] [-v]\n", argv[0]);
+    return 2;
+  }
+  bool per_frame = false;
+  bool events = false;
+  bool clutter = false;
+  for (int i = 2; i < argc; i++) {
+    if (std::string(argv[i]) == "--per-frame") {
+      per_frame = true;
+    } else if (std::string(argv[i]) == "--events") {
+      events = true;
+    } else if (std::string(argv[i]) == "--clutter") {
+      clutter = true;
+    } else if (std::string(argv[i]) == "-v") {
+      host::log_level = ESPHOME_LOG_LEVEL_DEBUG;
+    }
+  }
+
+  std::vector<CaptureFrame> capture = load_capture(argv[1]);
+  if (capture.empty()) {
+    std::fprintf(stderr, "no frames in %s\n", argv[1]);
+    return 1;
+  }
+
+  HostRadar radar;
+  if (clutter) {
+    radar.set_clutter_map(600000, 0.5f);
+  }
+  uint32_t config_ms = radar.start();
+  size_t config_commands = uart::host::uart_lines.size();
+
+  // Frames arrive 5 ms after their radar timestamp, starting once setup is done
+  const uint64_t base_us = host::now_us + 5000 - capture.front().radar_us;
+  std::vector<double> read_us, publish_us, spi_us;
+  size_t bytes = 0;
+  double total_ns = 0.0;
+  bool fallen[HostRadar::NUM_IDS + 1] = {};
+  struct Shown {
+    double start;
+    uint32_t frames;
+    bool seen;
+  };
+  std::map<uint8_t, Shown> shown;  // Open display episodes by radar ID
+  uint32_t suppressed = 0;
+  if (per_frame) {
+    std::printf("frame,bytes,parsed,tracks,read_us,publish_us\n");
+  }
+  for (size_t i = 0; i < capture.size(); i++) {
+    const CaptureFrame &frame = capture[i];
+    uint64_t at_us = base_us + frame.radar_us;
+    radar.idle_until(at_us);
+    HostRadar::FrameTiming timing = radar.feed(frame, std::max<uint64_t>(at_us, host::now_us));
+    bytes += frame.bytes.size();
+    total_ns += timing.read_ns + timing.publish_ns;
+    if (timing.parsed) {
+      read_us.push_back(timing.read_ns / 1000.0);
+      publish_us.push_back(timing.publish_ns / 1000.0);
+      spi_us.push_back(timing.spi_us);
+    }
+    if (per_frame) {
+      std::printf("%zu,%zu,%d,%u,%.2f,%.2f\n", i, frame.bytes.size(), timing.parsed,
+                  (unsigned) radar.get_last_frame().num_tracks, timing.read_ns / 1000.0, timing.publish_ns / 1000.0);
+    }
+    for (uint8_t id = 1; events && id <= HostRadar::NUM_IDS; id++) {
+      if (radar.entities[id].fall.state != fallen[id]) {
+        fallen[id] = radar.entities[id].fall.state;
+        std::printf("%s,%.3f,%u\n", fallen[id] ? "fall" : "clear", (frame.radar_us - capture.front().radar_us) / 1e6,
+                    id);
+      }
+    }
+    double t = (frame.radar_us - capture.front().radar_us) / 1e6;
+    for (uint8_t id = 1; clutter && timing.parsed && id <= HostRadar::NUM_IDS; id++) {
+      const TrackData *track = radar.track(id);
+      if (track != nullptr && track->last_seen + 1 == radar.frames()) {
+        Shown &episode = shown.emplace(track->radar_id, Shown{t, 0, false}).first->second;
+        episode.frames += !episode.seen;  // Once per frame, however many display IDs map to it
+        episode.seen = true;
+      }
+    }
+    for (auto it = shown.begin(); clutter && timing.parsed && it != shown.end();) {
+      if (!it->second.seen) {
+        std::printf("shown,%.3f,%u,%u\n", it->second.start, it->first, it->second.frames);
+        it = shown.erase(it);
+      } else {
+        (it++)->second.seen = false;
+      }
+    }
+    for (; clutter && suppressed < radar.clutter().suppressed_tracks(); suppressed++) {
+      std::printf("suppressed,%.3f\n", t);
+    }
+  }
+
+  if (clutter) {
+    const BoundaryBox &box = radar.get_tracking_boundary();
+    float cell_x = (box.x_max - box.x_min) / ClutterMap::GRID_SIZE;
+    float cell_y = (box.y_max - box.y_min) / ClutterMap::GRID_SIZE;
+    for (uint8_t cy = 0; cy < ClutterMap::GRID_SIZE; cy++) {
+      for (uint8_t cx = 0; cx < ClutterMap::GRID_SIZE; cx++) {
+        float x = box.x_min + (cx + 0.5f) * cell_x, y = box.y_min + (cy + 0.5f) * cell_y;
+        if (radar.clutter().score(x, y) >= 0.5f) {
+          std::printf("clutter_cell,%.3f,%.3f,%.2f\n", x, y, radar.clutter().score(x, y));
+        }
+      }
+    }
+    for (const auto &pair : shown) {
+      std::printf("shown,%.3f,%u,%u\n", pair.second.start, pair.first, pair.second.frames);
+    }
+    std::printf("frames,%u\n", radar.frames());
+  }
+
+  double mean = 0.0;
+  for (double v : read_us) {
+    mean += v / read_us.size();
+  }
+  std::fprintf(stderr, "%zu frames, %zu bytes: %u parsed, %u invalid, %u sync losses\n", capture.size(), bytes,
+               radar.frames(), radar.invalid_frames(), radar.sync_losses());
+  std::fprintf(stderr, "read_frame_ per frame: mean %.1f us, p50 %.1f us, p95 %.1f us, max %.1f us\n", mean,
+               percentile(read_us, 0.5), percentile(read_us, 0.95), percentile(read_us, 1.0));
+  std::fprintf(stderr, "publish drain per frame: p50 %.1f us, p95 %.1f us, max %.1f us\n",
+               percentile(publish_us, 0.5), percentile(publish_us, 0.95), percentile(publish_us, 1.0));
+  std::fprintf(stderr, "throughput: %.0f frames/s, %.1f MB/s (host)\n", capture.size() / (total_ns / 1e9),
+               bytes / (total_ns / 1e3));
+  std::fprintf(stderr, "setup: %zu UART commands, %u ms simulated (reset and config push)\n", config_commands,
+               config_ms);
+  std::vector<double> recent_spi_us(spi_us.end() - std::min(spi_us.size(), LATENCY_SAMPLES), spi_us.end());
+  double parse_p50 = radar.parse_latency().percentile(50) / 1000.0;
+  double spi_p50 = percentile(recent_spi_us, 0.5) / 1000.0;
+  bool latency_ok = parse_p50 > 0.0 && parse_p50 <= spi_p50;
+  std::fprintf(stderr, "capture-to-parse p50 %.2f ms, simulated SPI time per frame p50 %.2f ms%s\n", parse_p50,
+               spi_p50, latency_ok ? "" : " (FAIL: latency exceeds the transfer)");
+  return radar.frames() > 0 && latency_ok ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+// IWR6843Component on the host: frames from a simulator capture are clocked in through the stub SPI bus,
+// UART commands are collected, and the simulated clock follows the radar's frame timestamps.
+
+#include "iwr6843.h"
+#include "esphome/core/log.h"
+#include "host_test.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace iwr6843 {
+
+// One capture frame and the radar time it was stamped with
+struct CaptureFrame {
+  std::vector<uint8_t> bytes;
+  int64_t radar_us;
+};
+
+// Splits a capture at each magic word; radar time is unwrapped from the header's 200 MHz cycle stamp
+inline std::vector<CaptureFrame> load_capture(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  std::vector<size_t> starts;
+  for (size_t i = 0; i + MAGIC_WORD_SIZE <= data.size(); i++) {
+    if (data[i] == MAGIC_WORD[0] && memcmp(&data[i], MAGIC_WORD, MAGIC_WORD_SIZE) == 0) {
+      starts.push_back(i);
+    }
+  }
+
+  std::vector<CaptureFrame> frames;
+  uint32_t last_cycles = 0;
+  int64_t high = 0;
+  for (size_t i = 0; i < starts.size(); i++) {
+    size_t end = i + 1 < starts.size() ? starts[i + 1] : data.size();
+    CaptureFrame frame{std::vector<uint8_t>(data.begin() + starts[i], data.begin() + end), 0};
+    uint32_t cycles = last_cycles;
+    if (frame.bytes.size() >= 28) {
+      memcpy(&cycles, &frame.bytes[24], 4);
+    }
+    if (cycles < last_cycles) {
+      high += int64_t(1) << 32;
+    }
+    last_cycles = cycles;
+    frame.radar_us = (high + cycles) / RadarClock::DEFAULT_CPU_MHZ;
+    frames.push_back(std::move(frame));
+  }
+  return frames;
+}
+
+class HostRadar : public IWR6843Component {
+ public:
+  static const uint8_t NUM_IDS = 5;  // Display IDs 1-5
+
+  // Default YAML: ceiling mount at the simulator's default pose (2.9 m, pitch 90), boundaries, five tracking
+  // IDs with every per-person entity registered
+  HostRadar() {
+    this->set_ceiling_height(290);
+    this->set_mounting(0.0f, 0.0f, 0.0f, 90.0f, 0.0f);
+    this->set_tracking_boundary(-4.0f, 4.0f, -4.0f, 4.0f, -0.5f, 3.0f);
+    this->set_presence_boundary(-4.0f, 4.0f, -4.0f, 4.0f, -0.5f, 3.0f);
+    for (uint8_t id = 1; id <= NUM_IDS; id++) {
+      this->add_tracking_id(id, "Person " + std::to_string(id));
+      Entities &e = this->entities[id];
+      this->register_presence_sensor(id, &e.presence);
+      this->register_fall_sensor(id, &e.fall);
+      this->register_x_coordinate_sensor(id, &e.x);
+      this->register_y_coordinate_sensor(id, &e.y);
+      this->register_z_coordinate_sensor(id, &e.z);
+      this->register_velocity_sensor(id, &e.velocity);
+    }
+  }
+
+  struct Entities {
+    binary_sensor::BinarySensor presence;
+    binary_sensor::BinarySensor fall;
+    sensor::Sensor x, y, z, velocity;
+  };
+  Entities entities[NUM_IDS + 1];
+
+  // setup() with the blocking config push; returns simulated ms spent
+  uint32_t start() {
+    uart::host::uart_lines.clear();
+    uint32_t begin = millis();
+    this->setup();
+    return millis() - begin;
+  }
+
+  struct FrameTiming {
+    bool parsed;
+    double read_ns;     // read_frame_(): SPI copy, header, TLV parse, analytics, sensor updates
+    double publish_ns;  // drain_publish_queue_() on the same pass
+    uint64_t spi_us;    // Simulated SPI transfer time of the pass (magic search, header, body)
+  };
+
+  // One frame through the SPI read path and the rest of that loop() pass, at simulated time `at_us`
+  FrameTiming feed(const CaptureFrame &frame, uint64_t at_us) {
+    host::now_us = at_us;
+    spi::host::spi_bus.load(frame.bytes.data(), frame.bytes.size());
+    uint32_t now = millis();
+    this->pump_config_queue_(now);
+    uint64_t spi_start = host::now_us;
+    double start = now_ns();
+    bool parsed = this->read_frame_();
+    double read_done = now_ns();
+    uint64_t spi_us = host::now_us - spi_start;
+    this->supervise_link_(now, parsed);
+    double publish_start = now_ns();
+    this->drain_publish_queue_();
+    double publish_done = now_ns();
+    if (parsed && this->adaptive_frame_rate_) {
+      this->update_frame_rate_(millis());
+    }
+    this->run_timers();
+    return {parsed, read_done - start, publish_done - publish_start, spi_us};
+  }
+
+  // Plain loop() passes every `step_ms` with nothing on the bus, until `until_us`
+  void idle_until(uint64_t until_us, uint32_t step_ms = 10) {
+    spi::host::spi_bus.load(nullptr, 0);
+    while (host::now_us + step_ms * 1000 < until_us) {
+      host::now_us += step_ms * 1000;
+      this->loop();
+      this->run_timers();
+    }
+  }
+
+  const TrackData *track(uint8_t display_id) const {
+    auto it = this->tracks_.find(display_id);
+    return it == this->tracks_.end() ? nullptr : &it->second;
+  }
+  uint32_t frames() const { return this->frame_count_; }
+  uint32_t invalid_frames() const { return this->spi_invalid_frames_; }
+  uint32_t sync_losses() const { return this->spi_sync_losses_; }
+  const ClutterMap &clutter() const { return this->clutter_map_; }
+  const LatencyWindow &parse_latency() const { return this->parse_latency_; }
+};
+
+}  // namespace iwr6843
+}  // namespace esphome
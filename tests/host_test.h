@@ -0,0 +1,47 @@
+#pragma once
+
+// Minimal check helpers for the host tests; each test is a standalone program that returns non-zero
+// when a check fails.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+static int g_failures = 0;
+
+#define CHECK(cond) \
+  do { \
+    if (!(cond)) { \
+      std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      g_failures++; \
+    } \
+  } while (0)
+
+#define CHECK_NEAR(a, b, tol) \
+  do { \
+    double check_a_ = (a), check_b_ = (b); \
+    if (!(check_a_ - check_b_ <= (tol) && check_b_ - check_a_ <= (tol))) { \
+      std::printf("FAIL %s:%d: %s = %g, expected %g +/- %g\n", __FILE__, __LINE__, #a, check_a_, check_b_, \
+                  (double) (tol)); \
+      g_failures++; \
+    } \
+  } while (0)
+
+inline int test_result(const char *name) {
+  std::printf("%s: %s\n", name, g_failures == 0 ? "PASS" : "FAIL");
+  return g_failures == 0 ? 0 : 1;
+}
+
+// Value at fraction q (0..1) of the sorted samples
+inline double percentile(std::vector<double> values, double q) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  std::sort(values.begin(), values.end());
+  return values[std::min(values.size() - 1, (size_t) (q * (values.size() - 1) + 0.5))];
+}
+
+inline double now_ns() {
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+// Host stand-in for a sensor entity: keeps the last state and a publish count.
+
+#include <cstdint>
+
+namespace esphome {
+namespace sensor {
+
+class Sensor {
+ public:
+  void publish_state(float state) {
+    this->state = state;
+    this->publish_count++;
+  }
+
+  float state{0.0f};
+  uint32_t publish_count{0};
+};
+
+}  // namespace sensor
+}  // namespace esphome
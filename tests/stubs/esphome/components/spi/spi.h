@@ -0,0 +1,70 @@
+#pragma once
+
+// Host stand-in for the SPI bus: every device reads from host::spi_bus, which the test fills with
+// captured radar bytes. Reads past the end return the idle level, like a radar with nothing to send.
+// Each read advances the simulated clock by its transfer time at the device's data rate.
+
+#include "esphome/core/hal.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace spi {
+
+enum SPIBitOrder { BIT_ORDER_LSB_FIRST, BIT_ORDER_MSB_FIRST };
+enum SPIClockPolarity { CLOCK_POLARITY_LOW, CLOCK_POLARITY_HIGH };
+enum SPIClockPhase { CLOCK_PHASE_LEADING, CLOCK_PHASE_TRAILING };
+enum SPIDataRate : uint32_t {
+  DATA_RATE_1MHZ = 1000000,
+  DATA_RATE_2MHZ = 2000000,
+  DATA_RATE_4MHZ = 4000000,
+  DATA_RATE_8MHZ = 8000000,
+  DATA_RATE_10MHZ = 10000000,
+  DATA_RATE_20MHZ = 20000000,
+  DATA_RATE_40MHZ = 40000000,
+};
+
+struct HostBus {
+  std::vector<uint8_t> data;
+  size_t pos{0};
+  uint8_t idle{0x00};
+  size_t bytes_clocked{0};
+
+  void load(const uint8_t *bytes, size_t length) {
+    this->data.assign(bytes, bytes + length);
+    this->pos = 0;
+  }
+
+  void read(uint8_t *out, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+      out[i] = this->pos < this->data.size() ? this->data[this->pos++] : this->idle;
+    }
+    this->bytes_clocked += length;
+  }
+};
+
+namespace host {
+inline HostBus spi_bus;
+}  // namespace host
+
+template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, SPIDataRate DATA_RATE>
+class SPIDevice {
+ public:
+  void spi_setup() {}
+  void spi_teardown() {}
+  void enable() {}
+  void disable() {}
+  void set_data_rate(uint32_t data_rate) { this->data_rate_ = data_rate; }
+  void read_array(uint8_t *data, size_t length) {
+    host::spi_bus.read(data, length);
+    esphome::host::now_us += (uint64_t) length * 8 * 1000000 / this->data_rate_;
+  }
+
+ protected:
+  uint32_t data_rate_{DATA_RATE};
+};
+
+}  // namespace spi
+}  // namespace esphome
@@ -0,0 +1,35 @@
+#pragma once
+
+// Host stand-in for the UART: written lines are collected in host::uart_lines.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace uart {
+
+namespace host {
+inline std::vector<std::string> uart_lines;
+inline std::string uart_partial;
+}  // namespace host
+
+class UARTDevice {
+ public:
+  void write_byte(uint8_t data) {
+    if (data == '\n') {
+      host::uart_lines.push_back(host::uart_partial);
+      host::uart_partial.clear();
+    } else {
+      host::uart_partial += (char) data;
+    }
+  }
+  void write_str(const char *str) {
+    while (*str != '\0') {
+      this->write_byte((uint8_t) *str++);
+    }
+  }
+};
+
+}  // namespace uart
+}  // namespace esphome
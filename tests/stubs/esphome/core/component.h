@@ -0,0 +1,73 @@
+#pragma once
+
+// Host stand-in for Component: timeouts and intervals run on the simulated clock when the test calls
+// run_timers().
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "esphome/core/hal.h"
+
+namespace esphome {
+
+namespace setup_priority {
+const float DATA = 600.0f;
+}  // namespace setup_priority
+
+class Component {
+ public:
+  virtual ~Component() = default;
+  virtual void setup() {}
+  virtual void loop() {}
+  virtual void dump_config() {}
+  virtual void on_safe_shutdown() {}
+  virtual float get_setup_priority() const { return 0.0f; }
+
+  // Host only: fire due timeouts and intervals
+  void run_timers() {
+    uint32_t now = millis();
+    for (size_t i = 0; i < this->timers_.size(); i++) {
+      if ((int32_t) (now - this->timers_[i].due) < 0) {
+        continue;
+      }
+      std::function<void()> callback = this->timers_[i].callback;
+      if (this->timers_[i].interval != 0) {
+        this->timers_[i].due = now + this->timers_[i].interval;
+      } else {
+        this->timers_.erase(this->timers_.begin() + i--);
+      }
+      callback();
+    }
+  }
+
+ protected:
+  struct Timer {
+    std::string name;
+    uint32_t due;
+    uint32_t interval;  // 0 for a timeout
+    std::function<void()> callback;
+  };
+
+  void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f) {
+    this->set_timer_(name, timeout, 0, std::move(f));
+  }
+  void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f) {
+    this->set_timer_(name, interval, interval, std::move(f));
+  }
+
+  void set_timer_(const std::string &name, uint32_t delay, uint32_t interval, std::function<void()> &&f) {
+    for (size_t i = 0; i < this->timers_.size(); i++) {
+      if (this->timers_[i].name == name) {
+        this->timers_.erase(this->timers_.begin() + i);
+        break;
+      }
+    }
+    this->timers_.push_back({name, millis() + delay, interval, std::move(f)});
+  }
+
+  std::vector<Timer> timers_;
+};
+
+}  // namespace esphome
@@ -0,0 +1,29 @@
+#pragma once
+
+// Host stand-ins for the ESPHome HAL: a simulated clock the test advances, and a recording GPIO pin.
+
+#include <cstdint>
+
+namespace esphome {
+
+namespace host {
+inline uint64_t now_us = 0;  // Simulated time; delay() advances it
+}  // namespace host
+
+inline uint32_t millis() { return (uint32_t) (host::now_us / 1000); }
+inline uint32_t micros() { return (uint32_t) host::now_us; }
+inline void delay(uint32_t ms) { host::now_us += (uint64_t) ms * 1000; }
+inline void delayMicroseconds(uint32_t us) { host::now_us += us; }
+
+class GPIOPin {
+ public:
+  virtual ~GPIOPin() = default;
+  virtual void setup() {}
+  virtual void digital_write(bool value) { this->value_ = value; }
+  virtual bool digital_read() { return this->value_; }
+
+ protected:
+  bool value_{false};
+};
+
+}  // namespace esphome
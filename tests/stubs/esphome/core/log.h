@@ -0,0 +1,43 @@
+#pragma once
+
+// Host stand-in for ESPHome logging; messages at or above host::log_level (errors by default) go to stderr.
+
+#include <cstdarg>
+#include <cstdio>
+
+namespace esphome {
+
+#define ESPHOME_LOG_LEVEL_ERROR 1
+#define ESPHOME_LOG_LEVEL_WARN 2
+#define ESPHOME_LOG_LEVEL_INFO 3
+#define ESPHOME_LOG_LEVEL_CONFIG 4
+#define ESPHOME_LOG_LEVEL_DEBUG 5
+#define ESPHOME_LOG_LEVEL_VERBOSE 6
+
+namespace host {
+inline int log_level = ESPHOME_LOG_LEVEL_ERROR;
+
+inline void log(int level, const char *tag, const char *format, ...) {
+  if (level > log_level) {
+    return;
+  }
+  static const char LEVELS[] = "?EWICDV";
+  std::fprintf(stderr, "[%c][%s] ", LEVELS[level], tag);
+  va_list args;
+  va_start(args, format);
+  std::vfprintf(stderr, format, args);
+  va_end(args);
+  std::fputc('\n', stderr);
+}
+}  // namespace host
+
+#define ESP_LOGE(tag, ...) esphome::host::log(ESPHOME_LOG_LEVEL_ERROR, tag, __VA_ARGS__)
+#define ESP_LOGW(tag, ...) esphome::host::log(ESPHOME_LOG_LEVEL_WARN, tag, __VA_ARGS__)
+#define ESP_LOGI(tag, ...) esphome::host::log(ESPHOME_LOG_LEVEL_INFO, tag, __VA_ARGS__)
+#define ESP_LOGCONFIG(tag, ...) esphome::host::log(ESPHOME_LOG_LEVEL_CONFIG, tag, __VA_ARGS__)
+#define ESP_LOGD(tag, ...) esphome::host::log(ESPHOME_LOG_LEVEL_DEBUG, tag, __VA_ARGS__)
+#define ESP_LOGV(tag, ...) esphome::host::log(ESPHOME_LOG_LEVEL_VERBOSE, tag, __VA_ARGS__)
+
+#define YESNO(b) ((b) ? "YES" : "NO")
+
+}  // namespace esphome
@@ -0,0 +1,56 @@
+#pragma once
+
+// Host stand-in for flash preferences: an in-memory store that survives component re-creation within a test.
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <vector>
+
+namespace esphome {
+
+class ESPPreferenceObject {
+ public:
+  ESPPreferenceObject() = default;
+  explicit ESPPreferenceObject(std::vector<uint8_t> *data) : data_(data) {}
+
+  template<typename T> bool save(const T *src) {
+    if (this->data_ == nullptr) {
+      return false;
+    }
+    this->data_->assign(reinterpret_cast<const uint8_t *>(src), reinterpret_cast<const uint8_t *>(src) + sizeof(T));
+    return true;
+  }
+
+  template<typename T> bool load(T *dest) {
+    if (this->data_ == nullptr || this->data_->size() != sizeof(T)) {
+      return false;
+    }
+    std::memcpy(dest, this->data_->data(), sizeof(T));
+    return true;
+  }
+
+ protected:
+  std::vector<uint8_t> *data_{nullptr};
+};
+
+class ESPPreferences {
+ public:
+  template<typename T> ESPPreferenceObject make_preference(uint32_t type, bool in_flash = false) {
+    (void) in_flash;
+    return ESPPreferenceObject(&this->store_[type]);
+  }
+
+  void clear() { this->store_.clear(); }
+
+ protected:
+  std::map<uint32_t, std::vector<uint8_t>> store_;
+};
+
+namespace host {
+inline ESPPreferences preferences;
+}  // namespace host
+
+inline ESPPreferences *global_preferences = &host::preferences;
+
+}  // namespace esphome
@@ -0,0 +1,107 @@
+// MountingTransform: point-cloud throughput, and agreement between the transforms for a set of poses.
+//
+// - room_to_tracker followed by tracks_to_room must return the room position (boundaries sent to the
+//   radar and the tracks it reports use the same pose)
+// - a room point taken to the sensor frame the way tools/iwr6843_sim.py writes it must come back from
+//   points_to_room
+// - height_to_room must agree with a full tracker-to-room transform of the point above the target
+
+#include "mounting.h"
+#include "host_test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using esphome::iwr6843::MountingTransform;
+
+struct Pose {
+  float x, y, height, yaw, pitch, roll;
+};
+
+static const Pose POSES[] = {
+    {0.0f, 0.0f, 2.9f, 0.0f, 90.0f, 0.0f},    // Ceiling, default
+    {-2.0f, 0.5f, 2.2f, 90.0f, 15.0f, 0.0f},  // Wall unit (README example)
+    {1.0f, -1.5f, 2.5f, -30.0f, 45.0f, 0.0f},
+    {0.5f, 0.5f, 2.4f, 120.0f, 60.0f, 10.0f},  // Rolled: the tracker cannot model this part
+};
+
+// Room point to the sensor frame for yaw = roll = 0 and no x/y offset (the simulator's pose); x is unchanged
+static void room_to_sensor(float pitch, float height, float &y, float &z) {
+  const float deg = 3.14159265f / 180.0f;
+  float cp = cosf(pitch * deg), sp = sinf(pitch * deg);
+  float dz = z - height;
+  float sy = cp * y - sp * dz;
+  float sz = sp * y + cp * dz;
+  y = sy;
+  z = sz;
+}
+
+int main() {
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> room(-4.0f, 4.0f);
+  std::uniform_real_distribution<float> room_z(0.0f, 2.0f);
+
+  // Throughput: a full 256-point frame, many times over
+  MountingTransform transform;
+  transform.set_pose(-2.0f, 0.5f, 2.2f, 90.0f, 15.0f, 5.0f);
+  const size_t points = 256;
+  const int frames = 100000;
+  std::vector<float> x(points), y(points), z(points);
+  for (size_t i = 0; i < points; i++) {
+    x[i] = room(rng);
+    y[i] = room(rng);
+    z[i] = room_z(rng);
+  }
+  double start = now_ns();
+  for (int f = 0; f < frames; f++) {
+    transform.points_to_room(x.data(), y.data(), z.data(), points);
+    asm volatile("" : : "r"(x.data()), "r"(y.data()), "r"(z.data()) : "memory");  // Keep every pass
+  }
+  double ns_per_point = (now_ns() - start) / ((double) frames * points);
+  std::printf("points_to_room: %.2f ns/point, %.0f M points/s (host, %zu-point frames)\n", ns_per_point,
+              1e3 / ns_per_point, points);
+
+  double worst_track = 0.0, worst_point = 0.0, worst_height = 0.0;
+  for (const Pose &pose : POSES) {
+    transform.set_pose(pose.x, pose.y, pose.height, pose.yaw, pose.pitch, pose.roll);
+    for (int i = 0; i < 1000; i++) {
+      float px = room(rng), py = room(rng), pz = room_z(rng);
+
+      // Room -> tracker -> room
+      float tx = px, ty = py, tz = pz;
+      transform.room_to_tracker(tx, ty, tz);
+      float rx = tx, ry = ty, rz = tz, vx = 0.0f, vy = 0.0f, vz = 0.0f;
+      transform.tracks_to_room(&rx, &ry, &rz, &vx, &vy, &vz, 1);
+      worst_track = std::max(worst_track, (double) std::fabs(rx - px) + std::fabs(ry - py) + std::fabs(rz - pz));
+
+      // Target height: the tracker-frame point above the target, taken to the room frame
+      float height = tz + 0.8f;
+      float hx = tx, hy = ty, hz = height;
+      transform.tracks_to_room(&hx, &hy, &hz, &vx, &vy, &vz, 1);
+      worst_height = std::max(worst_height, (double) std::fabs(transform.height_to_room(px, py, pz, height) - hz));
+    }
+  }
+
+  // Sensor-frame points as the simulator writes them, for its own pose family
+  const float sim_pitches[] = {90.0f, 45.0f, 15.0f};
+  for (float pitch : sim_pitches) {
+    transform.set_pose(0.0f, 0.0f, 2.9f, 0.0f, pitch, 0.0f);
+    for (int i = 0; i < 1000; i++) {
+      float px = room(rng), py = room(rng), pz = room_z(rng);
+      float sx = px, sy = py, sz = pz;
+      room_to_sensor(pitch, 2.9f, sy, sz);
+      transform.points_to_room(&sx, &sy, &sz, 1);
+      worst_point = std::max(worst_point, (double) std::fabs(sx - px) + std::fabs(sy - py) + std::fabs(sz - pz));
+    }
+  }
+
+  std::printf("round trip, max error: room->tracker->room %.2g m, sensor->room %.2g m, height %.2g m\n",
+              worst_track, worst_point, worst_height);
+  CHECK(worst_track < 1e-4);
+  CHECK(worst_point < 1e-4);
+  CHECK(worst_height < 1e-4);
+
+  return test_result("mounting");
+}
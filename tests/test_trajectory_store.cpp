@@ -0,0 +1,203 @@
+// TrajectoryStore: encode cost and storage per hour for walking and still tracks, block reuse once a
+// track's share is full, and a decode round trip through tools/iwr6843_trajectory.py.
+//
+//   test_trajectory_store                            benchmark and checks
+//   test_trajectory_store response.txt expected.csv  write a /iwr6843/trajectory response and the CSV the
+//                                                    decoder must print for it (make run-trajectory-decode)
+
+#include "trajectory_store.h"
+#include "host_test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using esphome::iwr6843::TrajectoryStore;
+
+static const uint32_t FRAME_MS = 120;  // Active frame period
+static const uint32_t SAMPLES_PER_HOUR = 3600 * 1000 / FRAME_MS;
+
+struct Sample {
+  uint32_t t;  // ms
+  int16_t x, y, z;  // cm
+};
+
+// One hour of tracker output at the active frame rate: a person walking ~1 m/s around a 6 x 6 m room,
+// or standing; `jitter_cm` is the tracker's position noise
+static std::vector<Sample> person_hour(bool walking, float jitter_cm, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<float> noise(0.0f, std::max(jitter_cm, 1e-6f));
+  std::uniform_int_distribution<int> frame_jitter(-2, 2);
+  std::uniform_real_distribution<float> turn(-0.3f, 0.3f);
+  std::vector<Sample> samples;
+  float x = 0.0f, y = 150.0f, heading = 0.0f;
+  uint32_t t = 1000;
+  for (uint32_t i = 0; i < SAMPLES_PER_HOUR; i++) {
+    if (walking) {
+      heading += turn(rng);
+      x += 12.0f * std::cos(heading);
+      y += 12.0f * std::sin(heading);
+      if (std::fabs(x) > 300.0f || y < 0.0f || y > 600.0f) {
+        heading += 3.14159f;  // Turn back at the walls
+      }
+    }
+    samples.push_back({t, (int16_t) std::lround(x + noise(rng)), (int16_t) std::lround(y + noise(rng)),
+                       (int16_t) std::lround(100.0f + noise(rng))});
+    t += FRAME_MS + frame_jitter(rng);
+  }
+  return samples;
+}
+
+static void add(TrajectoryStore &store, uint8_t track, const Sample &s) {
+  store.add(track, s.t, s.x / 100.0f, s.y / 100.0f, s.z / 100.0f);
+}
+
+// Encode an hour into a store large enough to keep it all; returns ns per sample and bytes stored
+static void encode_hour(const std::vector<Sample> &samples, double &ns_per_sample, size_t &bytes) {
+  std::vector<uint8_t> buffer(1 << 20);  // ~800 blocks per track
+  TrajectoryStore store;
+  store.init(buffer.data(), buffer.size());
+  double start = now_ns();
+  for (const Sample &s : samples) {
+    add(store, 0, s);
+  }
+  ns_per_sample = (now_ns() - start) / samples.size();
+  bytes = 0;
+  store.read(0, samples.back().t, UINT32_MAX, [&bytes](const uint8_t *, size_t length) { bytes += length; });
+}
+
+static std::string base64(const uint8_t *data, size_t length) {
+  static const char *ALPHABET = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  for (size_t i = 0; i < length; i += 3) {
+    uint32_t chunk = data[i] << 16 | (i + 1 < length ? data[i + 1] << 8 : 0) | (i + 2 < length ? data[i + 2] : 0);
+    for (size_t j = 0; j < 4; j++) {
+      out += j <= (length - i) ? ALPHABET[(chunk >> (18 - 6 * j)) & 0x3F] : '=';
+    }
+  }
+  return out;
+}
+
+// Centimetres as the decoder prints metres ("-0.05", "1.20")
+static std::string metres(int cm) {
+  char text[16];
+  std::snprintf(text, sizeof(text), "%s%d.%02d", cm < 0 ? "-" : "", std::abs(cm) / 100, std::abs(cm) % 100);
+  return text;
+}
+
+// Several blocks across the millis() wrap, with a track restart, a gap longer than MAX_SAMPLE_GAP, large
+// and negative steps; the decoder must print exactly the quantized samples
+static int write_round_trip(const char *response_path, const char *expected_path) {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> step(-40, 40);
+  std::uniform_int_distribution<int> frame_jitter(-3, 3);
+  std::vector<Sample> samples;
+  uint32_t t = UINT32_MAX - 30000;
+  int x = -250, y = 30, z = 110;
+  for (int i = 0; i < 600; i++) {
+    if (i == 200) {
+      t += TrajectoryStore::MAX_SAMPLE_GAP + 5000;
+    } else if (i == 400) {
+      x += 350;  // Teleport: 350 cm step needs a two-byte delta
+      y -= 180;
+    }
+    x += step(rng);
+    y += step(rng);
+    z = std::max(0, std::min(200, z + step(rng) / 8));
+    samples.push_back({t, (int16_t) x, (int16_t) y, (int16_t) z});
+    t += FRAME_MS + frame_jitter(rng);
+  }
+
+  std::vector<uint8_t> buffer(64 * 1024);
+  TrajectoryStore store;
+  store.init(buffer.data(), buffer.size());
+  for (size_t i = 0; i < samples.size(); i++) {
+    if (i == 300) {
+      store.end(0);  // Track left and its display ID was reused
+    }
+    add(store, 0, samples[i]);
+  }
+
+  uint32_t now = samples.back().t + 500;
+  FILE *response = std::fopen(response_path, "w");
+  FILE *expected = std::fopen(expected_path, "w");
+  if (response == nullptr || expected == nullptr) {
+    std::printf("cannot write %s / %s\n", response_path, expected_path);
+    return 1;
+  }
+  std::fprintf(response, "now %u\n", now);
+  size_t blocks = 0;
+  store.read(0, now, UINT32_MAX, [response, &blocks](const uint8_t *data, size_t length) {
+    std::fprintf(response, "%s\n", base64(data, length).c_str());
+    blocks++;
+  });
+  std::fprintf(expected, "age_s,x,y,z\n");
+  for (const Sample &s : samples) {
+    uint32_t age = now - s.t;
+    std::fprintf(expected, "%u.%03u,%s,%s,%s\n", age / 1000, age % 1000, metres(s.x).c_str(), metres(s.y).c_str(),
+                 metres(s.z).c_str());
+  }
+  std::fclose(response);
+  std::fclose(expected);
+  std::printf("round trip: %zu samples in %zu blocks\n", samples.size(), blocks);
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc == 3) {
+    return write_round_trip(argv[1], argv[2]);
+  }
+
+  struct Case {
+    const char *name;
+    bool walking;
+    float jitter_cm;
+    double max_bytes_per_sample;
+  };
+  // The time varint is 2 bytes at 120 ms, moves add 1 byte per axis for steps under 64 cm
+  const Case cases[] = {
+      {"walking", true, 0.4f, 5.5},
+      {"still", false, 0.0f, 2.1},
+      {"still, jitter", false, 0.4f, 5.0},
+  };
+  for (const Case &c : cases) {
+    std::vector<Sample> samples = person_hour(c.walking, c.jitter_cm, 1);
+    double ns;
+    size_t bytes;
+    encode_hour(samples, ns, bytes);
+    double per_sample = (double) bytes / samples.size();
+    std::printf("%-14s encode %.1f ns/sample, %.2f bytes/sample, %.0f KB/hour at %u ms frames\n", c.name, ns,
+                per_sample, bytes / 1024.0, FRAME_MS);
+    CHECK(per_sample < c.max_bytes_per_sample);
+  }
+
+  // A full share reuses its oldest block: the newest blocks come back, oldest first
+  std::vector<uint8_t> small(5 * TrajectoryStore::MAX_TRACKS * TrajectoryStore::BLOCK_SIZE);
+  TrajectoryStore store;
+  CHECK(store.init(small.data(), small.size()));
+  std::vector<Sample> samples = person_hour(true, 0.4f, 2);
+  for (const Sample &s : samples) {
+    add(store, 3, s);
+  }
+  std::vector<uint32_t> keyframes;
+  store.read(3, samples.back().t, UINT32_MAX, [&keyframes](const uint8_t *data, size_t) {
+    keyframes.push_back(data[0] | data[1] << 8 | data[2] << 16 | (uint32_t) data[3] << 24);
+  });
+  CHECK(keyframes.size() == 5);
+  CHECK(std::is_sorted(keyframes.begin(), keyframes.end()));
+  CHECK(samples.back().t - keyframes.front() < 5 * 60 * FRAME_MS);
+
+  // Other tracks stay empty, and a window shorter than the newest block's age returns nothing
+  size_t other = 0;
+  store.read(0, samples.back().t, UINT32_MAX, [&other](const uint8_t *, size_t) { other++; });
+  CHECK(other == 0);
+  size_t stale = 0;
+  store.read(3, samples.back().t + 10000, 5000, [&stale](const uint8_t *, size_t) { stale++; });
+  CHECK(stale == 0);
+
+  return test_result("trajectory_store");
+}
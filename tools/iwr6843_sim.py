@@ -0,0 +1,463 @@
+#!/usr/bin/env python3
+"""IWR6843 radar simulator for load testing the ESPHome component without hardware.
+
+Generates TI mmWave frames (magic word, 40-byte header, TLVs 1/6/7/8/9) from
+scripted or random trajectories and emulates the UART configuration CLI.
+
+Examples:
+    # 20 random walkers at 10 fps, 30 s capture to a file
+    tools/iwr6843_sim.py frames --targets 20 --fps 10 --duration 30 -o capture.bin
+
+    # Stream frames over TCP (e.g. to a mock SPI bus) with fault injection
+    tools/iwr6843_sim.py frames --serve 5000 --drop-bytes 0.01 --bad-length 0.005 --frame-gap 0.01
+
+    # Scripted trajectories (see SCRIPT FORMAT below)
+    tools/iwr6843_sim.py frames --script fall.json -o fall.bin
+
+    # CLI emulator on a pseudo-terminal; point the UART at the printed device
+    tools/iwr6843_sim.py cli
+
+    # Both: the CLI's frameCfg periodicity drives the frame stream
+    tools/iwr6843_sim.py cli --serve 5000
+
+    # One hour with 2 people and 3 clutter sources that keep spawning ghost tracks
+    tools/iwr6843_sim.py frames --targets 2 --ghosts 3 --duration 3600 --no-realtime -o clutter.bin
+
+FRAMES:
+    Like the radar, the simulator writes points in the sensor frame (x right, y
+    boresight, z up on the board) and tracks and heights in the tracker frame.
+    The sensor sits above the room origin at --height (m), tilted down by
+    --pitch (degrees, 90 = ceiling), so the tracker frame is the room frame.
+    The CLI emulator's sensorPosition command updates both.
+
+SCRIPT FORMAT (JSON):
+    {"targets": [{"waypoints": [[t_s, x, y, z], ...], "height": 1.7, "fall_at": 4.0,
+                  "heights": [[t_s, max_z, min_z], ...], "no_height": [[t_s, t_s], ...]}],
+     "ghosts": [[x, y], ...]}
+    Positions are linearly interpolated between waypoints. "fall_at" drops the
+    target's height extent to lying within one frame at that time. "heights"
+    keyframes (interpolated the same way) script gradual posture changes such as
+    sitting down or a slow collapse. "no_height" intervals leave the target out of
+    the target height TLV, as the radar does for a target with few points. A
+    target without waypoints walks at random.
+    "ghosts" places clutter sources (see --ghosts) at fixed positions.
+"""
+import argparse
+import json
+import math
+import os
+import random
+import socket
+import struct
+import sys
+import threading
+import time
+import tty
+
+MAGIC_WORD = bytes([0x02, 0x01, 0x04, 0x03, 0x06, 0x05, 0x08, 0x07])
+FRAME_HEADER_SIZE = 40
+PLATFORM_IWR6843 = 0xA6843
+HEADER_VERSION = 0x03060000
+RADAR_CPU_HZ = 200_000_000  # R4F clock behind time_cpu_cycles
+
+TLVTYPE_DETECTED_POINTS = 1
+TLVTYPE_POINT_CLOUD = 6
+TLVTYPE_TARGET_HEIGHT = 7
+TLVTYPE_TRACKED_TARGETS = 8
+TLVTYPE_COMPRESSED_SPHERICAL_POINTS = 9
+
+TRACK_SIZE = 68  # Matches the component's TLV 8 parser
+POINTS_PER_TARGET = 12
+POINTS_PER_GHOST = 4
+GHOST_ID_BASE = 100  # Ghost track IDs cycle through 100-249
+
+# Compressed point units: elevation, azimuth, doppler, range, snr
+COMPRESSED_UNITS = (0.01, 0.01, 0.01, 0.00025, 0.04)
+
+# CLI command latencies (s), roughly as measured on the mmWave SDK demo
+CLI_LATENCY = {"sensorStart": 0.060, "sensorStop": 0.020, "flushCfg": 0.010}
+CLI_DEFAULT_LATENCY = 0.004
+
+
+def interpolate(keyframes, t):
+    """Linear interpolation over [[t, v0, v1, ...], ...] keyframes, held at both ends."""
+    if t <= keyframes[0][0]:
+        return list(keyframes[0][1:])
+    for (t0, *p0), (t1, *p1) in zip(keyframes, keyframes[1:]):
+        if t0 <= t <= t1:
+            f = (t - t0) / (t1 - t0) if t1 > t0 else 0.0
+            return [a + (b - a) * f for a, b in zip(p0, p1)]
+    return list(keyframes[-1][1:])
+
+
+class Target:
+    """One simulated person: position, velocity and height extent over time."""
+
+    def __init__(self, tid, waypoints=None, height=1.7, fall_at=None, bounds=4.0, heights=None, no_height=None):
+        self.tid = tid
+        self.waypoints = waypoints
+        self.height = height
+        self.fall_at = fall_at
+        self.heights = heights
+        self.no_height = no_height or []
+        self.bounds = bounds
+        self.pos = [random.uniform(-bounds, bounds), random.uniform(-bounds, bounds), height / 2]
+        self.vel = [random.uniform(-0.5, 0.5), random.uniform(-0.5, 0.5), 0.0]
+
+    def step(self, t, dt):
+        if self.waypoints:
+            pos = self._interpolate(t)
+            self.vel = [(pos[i] - self.pos[i]) / dt for i in range(3)] if dt > 0 else [0.0] * 3
+            self.pos = pos
+        else:
+            # Random walk, bouncing off the boundary
+            for i in range(2):
+                self.vel[i] += random.gauss(0.0, 0.2) * dt
+                self.vel[i] = max(-1.2, min(1.2, self.vel[i]))
+                self.pos[i] += self.vel[i] * dt
+                if abs(self.pos[i]) > self.bounds:
+                    self.vel[i] = -self.vel[i]
+                    self.pos[i] = math.copysign(self.bounds, self.pos[i])
+
+        max_z, min_z = self.height, 0.0
+        if self.heights:
+            max_z, min_z = interpolate(self.heights, t)
+        if self.fall_at is not None and t >= self.fall_at:
+            max_z, min_z = 0.35, 0.05
+            self.vel[2] = -2.0 if t - self.fall_at < dt else 0.0
+            self.pos[2] = 0.2
+        elif not self.waypoints:
+            self.pos[2] = self.height / 2
+        return max_z, min_z
+
+    def _interpolate(self, t):
+        return interpolate(self.waypoints, t)
+
+    def reports_height(self, t):
+        return not any(start <= t < end for start, end in self.no_height)
+
+
+class Ghost:
+    """Static clutter (fan, curtain): points every frame, and a tracker ghost now and then."""
+
+    def __init__(self, bounds=4.0, center=None):
+        if center is None:
+            center = [random.uniform(-bounds, bounds), random.uniform(-bounds, bounds)]
+        self.center = [center[0], center[1], 1.0]
+        self.tid = None
+        self.height = random.uniform(0.8, 1.8)
+        self.pos = list(self.center)
+        self.vel = [0.0, 0.0, 0.0]
+        self.next_change = random.uniform(5.0, 60.0)
+
+    def step(self, t, next_tid):
+        """Advance to time t; returns True while a ghost track is reported."""
+        if t >= self.next_change:
+            if self.tid is None:
+                self.tid = next_tid()
+                self.next_change = t + random.uniform(2.0, 20.0)
+            else:
+                self.tid = None
+                self.next_change = t + random.uniform(5.0, 60.0)
+        self.pos = [c + random.gauss(0.0, 0.05) for c in self.center]
+        self.vel = [random.gauss(0.0, 0.1), math.sin(t * 6.0) * 0.5, 0.0]
+        return self.tid is not None
+
+    def points(self):
+        return [
+            (
+                self.center[0] + random.gauss(0.0, 0.1),
+                self.center[1] + random.gauss(0.0, 0.1),
+                random.uniform(0.2, self.height),
+                self.vel[1] + random.gauss(0.0, 0.1),
+                random.uniform(3.0, 12.0),
+            )
+            for _ in range(POINTS_PER_GHOST)
+        ]
+
+
+def tlv(tlv_type, payload):
+    return struct.pack("<II", tlv_type, len(payload)) + payload
+
+
+def room_to_sensor(x, y, z, height, pitch):
+    """Room-frame point to the sensor frame of a sensor at (0, 0, height) tilted down by pitch (degrees)."""
+    cp, sp = math.cos(math.radians(pitch)), math.sin(math.radians(pitch))
+    dz = z - height
+    return x, cp * y - sp * dz, sp * y + cp * dz
+
+
+def spherical(x, y, z):
+    rng = math.sqrt(x * x + y * y + z * z)
+    azimuth = math.atan2(x, y)
+    elevation = math.asin(z / rng) if rng > 0 else 0.0
+    return rng, azimuth, elevation
+
+
+def build_frame(frame_number, cpu_cycles, targets, heights, extra_points=(), pose=(2.9, 90.0), no_height=()):
+    """Build one complete frame (magic word + header + TLVs); `pose` is the sensor (height, pitch).
+
+    Targets whose ID is in `no_height` get no target height record.
+    """
+    points = list(extra_points)
+    for target in targets:
+        for _ in range(POINTS_PER_TARGET):
+            x = target.pos[0] + random.gauss(0.0, 0.1)
+            y = target.pos[1] + random.gauss(0.0, 0.1)
+            z = random.uniform(0.1, heights[target.tid][0])
+            doppler = target.vel[1] + random.gauss(0.0, 0.05)
+            points.append((x, y, z, doppler, random.uniform(5.0, 30.0)))
+    points = [(*room_to_sensor(x, y, z, *pose), d, snr) for x, y, z, d, snr in points]
+
+    detected = b"".join(struct.pack("<4f", x, y, z, d) for x, y, z, d, _ in points)
+    cloud = b"".join(struct.pack("<4f", *spherical(x, y, z), d) for x, y, z, d, _ in points)
+
+    elev_u, azim_u, doppler_u, range_u, snr_u = COMPRESSED_UNITS
+    compressed = struct.pack("<5f", *COMPRESSED_UNITS)
+    for x, y, z, d, snr in points:
+        rng, azimuth, elevation = spherical(x, y, z)
+        compressed += struct.pack(
+            "<bbhHH",
+            max(-128, min(127, round(elevation / elev_u))),
+            max(-128, min(127, round(azimuth / azim_u))),
+            max(-32768, min(32767, round(d / doppler_u))),
+            min(65535, round(rng / range_u)),
+            min(65535, round(snr / snr_u)),
+        )
+
+    tracks = b""
+    height_records = b""
+    for target in targets:
+        track = struct.pack("<I9f", target.tid, *target.pos, *target.vel, 0.0, 0.0, 0.0)
+        track += struct.pack("<2f", 0.0, random.uniform(0.6, 1.0))  # Confidence at offset 44
+        tracks += track.ljust(TRACK_SIZE, b"\x00")
+        if target.tid not in no_height:
+            height_records += struct.pack("<I2f", target.tid, *heights[target.tid])
+
+    body = (
+        tlv(TLVTYPE_DETECTED_POINTS, detected)
+        + tlv(TLVTYPE_POINT_CLOUD, cloud)
+        + tlv(TLVTYPE_TARGET_HEIGHT, height_records)
+        + tlv(TLVTYPE_TRACKED_TARGETS, tracks)
+        + tlv(TLVTYPE_COMPRESSED_SPHERICAL_POINTS, compressed)
+    )
+    header = MAGIC_WORD + struct.pack(
+        "<8I",
+        HEADER_VERSION,
+        FRAME_HEADER_SIZE + len(body),
+        PLATFORM_IWR6843,
+        frame_number,
+        cpu_cycles & 0xFFFFFFFF,
+        len(points),
+        5,
+        0,
+    )
+    return header + body
+
+
+def inject_faults(frame, args, stats):
+    """Apply configured faults to an encoded frame."""
+    if args.bad_length and random.random() < args.bad_length:
+        bad = random.choice([0, FRAME_HEADER_SIZE - 1, 0x7FFFFFFF, len(frame) * 4])
+        frame = frame[:12] + struct.pack("<I", bad) + frame[16:]
+        stats["bad_length"] += 1
+    if args.drop_bytes and random.random() < args.drop_bytes:
+        start = random.randrange(len(frame))
+        count = random.randint(1, 16)
+        frame = frame[:start] + frame[start + count :]
+        stats["dropped_bytes"] += count
+    return frame
+
+
+class FrameSource:
+    """Produces frames in real time (or as fast as possible) from the targets."""
+
+    def __init__(self, args):
+        self.args = args
+        self.period = 1.0 / args.fps
+        self.pose = (args.height, args.pitch)
+        self.running = True
+        self.stats = {"frames": 0, "bytes": 0, "bad_length": 0, "dropped_bytes": 0, "gaps": 0}
+        self.clock_drift = 1.0 + args.drift_ppm / 1e6
+        if args.script:
+            with open(args.script, encoding="utf-8") as f:
+                script = json.load(f)
+            self.targets = [
+                Target(i, t.get("waypoints"), t.get("height", 1.7), t.get("fall_at"), heights=t.get("heights"),
+                       no_height=t.get("no_height"))
+                for i, t in enumerate(script["targets"])
+            ]
+            self.ghosts = [Ghost(center=center) for center in script.get("ghosts", [])]
+        else:
+            self.targets = [Target(i) for i in range(args.targets)]
+            self.ghosts = []
+        self.ghosts += [Ghost() for _ in range(args.ghosts)]
+        self.ghost_tid = 0
+        self.stats["ghost_tracks"] = 0
+
+    def next_ghost_tid(self):
+        self.ghost_tid = (self.ghost_tid + 1) % 150
+        self.stats["ghost_tracks"] += 1
+        return GHOST_ID_BASE + self.ghost_tid
+
+    def set_period(self, period_s):
+        self.period = period_s
+
+    def set_pose(self, height, pitch):
+        self.pose = (height, pitch)
+
+    def frames(self):
+        frame_number = 0
+        t = 0.0
+        start = time.monotonic()
+        while self.running and (self.args.duration <= 0 or t < self.args.duration):
+            heights = {target.tid: target.step(t, self.period) for target in self.targets}
+            cpu_cycles = int(t * RADAR_CPU_HZ * self.clock_drift)
+            frame_number += 1
+            if self.args.frame_gap and random.random() < self.args.frame_gap:
+                frame_number += random.randint(1, 3)
+                self.stats["gaps"] += 1
+
+            ghosts = [ghost for ghost in self.ghosts if ghost.step(t, self.next_ghost_tid)]
+            heights.update({ghost.tid: (ghost.height, 0.0) for ghost in ghosts})
+            clutter = [point for ghost in self.ghosts for point in ghost.points()]
+            no_height = {target.tid for target in self.targets if not target.reports_height(t)}
+            frame = build_frame(frame_number, cpu_cycles, self.targets + ghosts, heights, clutter, self.pose, no_height)
+            frame = inject_faults(frame, self.args, self.stats)
+            self.stats["frames"] += 1
+            self.stats["bytes"] += len(frame)
+            yield frame
+
+            t += self.period
+            if self.args.realtime:
+                delay = start + t - time.monotonic()
+                if delay > 0:
+                    time.sleep(delay)
+
+
+def write_frames(source, out):
+    for frame in source.frames():
+        out.write(frame)
+        out.flush()
+
+
+def serve_frames(source, port):
+    server = socket.create_server(("0.0.0.0", port))
+    print(f"Serving frames on tcp://0.0.0.0:{port}", file=sys.stderr)
+    conn, addr = server.accept()
+    print(f"Client connected from {addr[0]}:{addr[1]}", file=sys.stderr)
+    with conn:
+        try:
+            for frame in source.frames():
+                conn.sendall(frame)
+        except (BrokenPipeError, ConnectionResetError):
+            pass
+
+
+def report(source, elapsed):
+    stats = source.stats
+    rate = stats["frames"] / elapsed if elapsed > 0 else 0.0
+    print(
+        f"{stats['frames']} frames, {stats['bytes']} bytes in {elapsed:.1f} s "
+        f"({rate:.1f} fps, {stats['bytes'] / max(elapsed, 1e-9) / 1024:.1f} KB/s); "
+        f"faults: {stats['bad_length']} bad lengths, {stats['dropped_bytes']} dropped bytes, "
+        f"{stats['gaps']} frame gaps, {stats['ghost_tracks']} ghost tracks",
+        file=sys.stderr,
+    )
+
+
+def run_cli(args, source=None):
+    """Emulate the mmWave CLI on a pseudo-terminal: echo, 'Done' and realistic latencies."""
+    master, slave = os.openpty()
+    tty.setraw(slave)  # No line-discipline echo; the emulator echoes like the real CLI
+    print(f"CLI emulator on {os.ttyname(slave)}", file=sys.stderr)
+    push_start = None
+    commands = 0
+    line = b""
+    while True:
+        data = os.read(master, 256)
+        if not data:
+            break
+        line += data
+        while b"\n" in line:
+            raw, line = line.split(b"\n", 1)
+            command = raw.decode(errors="replace").strip()
+            if not command:
+                continue
+            name = command.split()[0]
+            if push_start is None:
+                push_start = time.monotonic()
+            commands += 1
+
+            time.sleep(CLI_LATENCY.get(name, CLI_DEFAULT_LATENCY))
+            os.write(master, f"{command}\r\nDone\r\nmmwDemo:/>".encode())
+
+            if name == "frameCfg" and source is not None:
+                period_ms = float(command.split()[5])
+                source.set_period(period_ms / 1000.0)
+                print(f"frameCfg: period {period_ms:.2f} ms", file=sys.stderr)
+            if name == "sensorPosition" and source is not None:
+                height, _, pitch = (float(v) for v in command.split()[1:4])
+                source.set_pose(height, pitch)
+                print(f"sensorPosition: height {height:.2f} m, pitch {pitch:.1f} deg", file=sys.stderr)
+            if name == "sensorStart":
+                elapsed = time.monotonic() - push_start
+                print(f"Config push: {commands} commands in {elapsed * 1000:.0f} ms", file=sys.stderr)
+                push_start = None
+                commands = 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="mode", required=True)
+
+    def add_frame_options(p):
+        p.add_argument("--targets", type=int, default=3, help="random-walk targets (ignored with --script)")
+        p.add_argument("--script", help="JSON trajectory script")
+        p.add_argument("--ghosts", type=int, default=0, help="static clutter sources that spawn ghost tracks")
+        p.add_argument("--height", type=float, default=2.9, help="sensor height above the floor, m (default 2.9)")
+        p.add_argument("--pitch", type=float, default=90.0, help="sensor downward tilt, degrees (default 90)")
+        p.add_argument("--fps", type=float, default=1000.0 / 120.0, help="frame rate (default 8.33)")
+        p.add_argument("--duration", type=float, default=0.0, help="seconds of simulated time (0 = forever)")
+        p.add_argument("--no-realtime", dest="realtime", action="store_false", help="generate as fast as possible")
+        p.add_argument("--drop-bytes", type=float, default=0.0, help="per-frame probability of dropping bytes")
+        p.add_argument("--bad-length", type=float, default=0.0, help="per-frame probability of a bad length")
+        p.add_argument("--frame-gap", type=float, default=0.0, help="per-frame probability of a frame-number gap")
+        p.add_argument("--drift-ppm", type=float, default=0.0, help="radar clock drift vs. wall time")
+        p.add_argument("--seed", type=int, help="random seed for reproducible captures")
+        p.add_argument("-o", "--output", help="write frames to a file ('-' for stdout)")
+        p.add_argument("--serve", type=int, metavar="PORT", help="stream frames to one TCP client")
+
+    add_frame_options(sub.add_parser("frames", help="generate a frame stream"))
+    add_frame_options(sub.add_parser("cli", help="emulate the UART CLI (optionally with frames)"))
+    args = parser.parse_args()
+
+    if args.seed is not None:
+        random.seed(args.seed)
+
+    source = FrameSource(args)
+    start = time.monotonic()
+    try:
+        if args.mode == "cli":
+            if args.serve:
+                threading.Thread(target=serve_frames, args=(source, args.serve), daemon=True).start()
+            run_cli(args, source if args.serve else None)
+        elif args.serve:
+            serve_frames(source, args.serve)
+        elif args.output:
+            if args.output == "-":
+                write_frames(source, sys.stdout.buffer)
+            else:
+                with open(args.output, "wb") as out:
+                    write_frames(source, out)
+        else:
+            parser.error("frames mode needs --output or --serve")
+    except KeyboardInterrupt:
+        pass
+    finally:
+        source.running = False
+        report(source, time.monotonic() - start)
+
+
+if __name__ == "__main__":
+    main()
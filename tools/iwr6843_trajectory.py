@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""Fetch and decode IWR6843 trajectory history from the device web server.
+
+Prints one CSV row per sample: seconds ago, x, y, z (m).
+
+Examples:
+    # Where was person 2 over the last 10 minutes
+    tools/iwr6843_trajectory.py http://radar.local 2 --window 600
+
+    # Decode a saved response
+    tools/iwr6843_trajectory.py --file person2.txt
+
+BLOCK FORMAT (see components/iwr6843/trajectory_store.h):
+    Keyframe: uint32 time (ms), int16 x, y, z (cm), little-endian.
+    Samples: varint (dt_ms << 1 | moved), then zigzag varint dx, dy, dz (cm) if moved.
+"""
+import argparse
+import base64
+import struct
+import sys
+import urllib.request
+
+
+def read_varint(data, pos):
+    value = shift = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if byte < 0x80:
+            return value, pos
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def decode_block(data):
+    """Yield (time_ms, x_cm, y_cm, z_cm) for every sample in a block."""
+    t, x, y, z = struct.unpack_from("<Ihhh", data)
+    yield t, x, y, z
+    pos = 10
+    while pos < len(data):
+        header, pos = read_varint(data, pos)
+        t = (t + (header >> 1)) & 0xFFFFFFFF
+        if header & 1:
+            for axis in range(3):
+                delta, pos = read_varint(data, pos)
+                if axis == 0:
+                    x += unzigzag(delta)
+                elif axis == 1:
+                    y += unzigzag(delta)
+                else:
+                    z += unzigzag(delta)
+        yield t, x, y, z
+
+
+def decode_response(text):
+    lines = text.strip().splitlines()
+    if not lines or not lines[0].startswith("now "):
+        raise ValueError("not a trajectory response")
+    now = int(lines[0].split()[1])
+    samples = []
+    for line in lines[1:]:
+        samples.extend(decode_block(base64.b64decode(line)))
+    # Blocks are self-contained; a block reused while reading may arrive out of order
+    samples.sort(key=lambda s: (now - s[0]) & 0xFFFFFFFF, reverse=True)
+    return now, samples
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("url", nargs="?", help="device base URL, e.g. http://radar.local")
+    parser.add_argument("id", nargs="?", type=int, help="display ID 1-5")
+    parser.add_argument("--window", type=int, default=600, help="seconds of history (default 600)")
+    parser.add_argument("--file", help="decode a saved response instead of fetching")
+    args = parser.parse_args()
+
+    if args.file:
+        with open(args.file, encoding="ascii") as f:
+            text = f.read()
+    elif args.url and args.id:
+        url = f"{args.url.rstrip('/')}/iwr6843/trajectory?id={args.id}&window={args.window}"
+        with urllib.request.urlopen(url, timeout=10) as response:
+            text = response.read().decode("ascii")
+    else:
+        parser.error("give a URL and ID, or --file")
+
+    now, samples = decode_response(text)
+    print("age_s,x,y,z")
+    for t, x, y, z in samples:
+        age = ((now - t) & 0xFFFFFFFF) / 1000.0
+        if age <= args.window:
+            print(f"{age:.3f},{x / 100:.2f},{y / 100:.2f},{z / 100:.2f}")
+    print(f"{len(samples)} samples", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()